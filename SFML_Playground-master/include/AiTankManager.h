@@ -0,0 +1,156 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "TankAI.h"
+#include "JobSystem.h"
+#include "NavigationGrid.h"
+#include "FlowField.h"
+#include "LevelLoader.h"
+
+class Tank;
+
+/// <summary>
+/// @brief Owns and updates every AI controlled tank in the level.
+/// 
+/// The manager also owns the navigation grid, baked from the walls by init, and the flow
+/// field towards the player that every tank follows while attacking.
+/// An update runs in three phases:
+///  1. prepare - serial: the flow field takes a step towards the player's position.
+///  2. steer - parallel on the job system: seek, patrol and collision avoidance steering,
+///     movement and projectiles. Each tank only changes its own state here, and draws its
+///     random patrol points from its own stream of a counter-based generator (see
+///     CounterRandom), so the numbers do not depend on which tanks run first.
+///  3. apply - serial, in tank order: collisions with the player are turned into player
+///     damage (see applyDamage), and each tank's projectile hits are gathered into one
+///     buffer of collision events (see collectEvents) for the game to apply.
+/// Because the parallel phase only touches per-tank data, the result of an update does not
+/// depend on the number of threads.
+/// </summary>
+class AiTankManager
+{
+public:
+	/// <summary>
+	/// @brief Constructor that stores references to what every AI tank needs.
+	/// </summary>
+	/// <param name="texture">A reference to the sprite sheet texture</param>
+	/// <param name="walls">A reference to the grid of wall sprites</param>
+	/// <param name="jobs">The job system used to steer the tanks in parallel</param>
+	AiTankManager(sf::Texture const & texture, WallGrid const & walls, JobSystem & jobs);
+
+	/// <summary>
+	/// @brief Creates one AI tank for each entry in the level data, replacing any existing tanks.
+	/// Bakes the navigation grid and builds the whole flow field. The wall grid must already be built.
+	/// </summary>
+	/// <param name="tanks">The AI tank data from the level</param>
+	/// <param name="playerPosition">The starting position of the player tank</param>
+	/// <param name="random">The generator the tanks draw their random numbers from</param>
+	void init(std::vector<TankData> const & tanks, sf::Vector2f playerPosition, CounterRandom const & random);
+
+	/// <summary>
+	/// @brief Runs the prepare and steer phases for every AI tank.
+	/// </summary>
+	/// <param name="playerTank">A reference to the player tank</param>
+	/// <param name="dt">update delta time</param>
+	/// <param name="tick">The simulation update number, stored in the collision events</param>
+	void update(Tank const & playerTank, double dt, std::uint32_t tick);
+
+	/// <summary>
+	/// @brief Part of the apply phase, damages the player once for each AI tank touching it.
+	/// </summary>
+	/// <param name="playerTank">A reference to the player tank</param>
+	void applyDamage(Tank & playerTank);
+
+	/// <summary>
+	/// @brief Part of the apply phase, adds the projectile hits of every AI tank during the
+	///  last update to a buffer, in tank order.
+	/// </summary>
+	/// <param name="events">Appended with the collision events</param>
+	void collectEvents(CollisionEventBuffer & events) const;
+
+	/// <summary>
+	/// @brief Adds the visual effects every AI tank started in the last update, in tank order.
+	/// </summary>
+	/// <param name="effects">The effects to add to</param>
+	void collectEffects(std::vector<EffectEvent> & effects) const;
+
+	/// <summary>
+	/// @brief Adds the projectiles, tank bases and turrets of the AI tanks in an area to the sprites to draw.
+	/// </summary>
+	/// <param name="sprites">The sprites to draw with the sprite sheet texture</param>
+	/// <param name="area">The part of the world being drawn, grown by the size of a tank</param>
+	void render(std::vector<SpriteInstance> & sprites, sf::FloatRect const & area) const;
+
+	/// <summary>
+	/// @brief Copies the vision cones that reach into an area, to be drawn as triangle fans.
+	/// </summary>
+	/// <param name="vertices">Appended with the vertices of every cone, one after another</param>
+	/// <param name="sizes">Appended with the vertex count of each cone</param>
+	/// <param name="area">The part of the world being drawn</param>
+	void renderVision(std::vector<sf::Vertex> & vertices, std::vector<int> & sizes, sf::FloatRect const & area) const;
+
+	/// <summary>
+	/// @brief Makes colliders for every AI tank, in tank order.
+	/// The colliders are valid until the AI tanks next move.
+	/// </summary>
+	/// <returns>A reference to the colliders, rebuilt by each call.</returns>
+	std::vector<TankColliders> const & getColliders();
+
+	/// <summary>
+	/// @brief Damages one AI tank.
+	/// </summary>
+	/// <param name="index">The index of the tank, as used by getColliders</param>
+	void takeDamage(int index);
+
+	/// <summary>
+	/// @brief Gets the number of AI tanks.
+	/// </summary>
+	/// <returns>The tank count.</returns>
+	int getCount() const;
+
+	/// <summary>
+	/// @brief Gets the flow field that leads to the player.
+	/// </summary>
+	/// <returns>A reference to the flow field.</returns>
+	FlowField const & getFlowField() const;
+
+	/// <summary>
+	/// @brief Gets one AI tank.
+	/// </summary>
+	/// <param name="index">The index of the tank</param>
+	/// <returns>A reference to the tank.</returns>
+	TankAi const & getTank(int index) const;
+
+	/// <summary>
+	/// @brief Adds every AI tank, in order, to a hash of the simulation state.
+	/// </summary>
+	/// <param name="hash">The hash to add to</param>
+	void hashState(StateHash & hash) const;
+
+private:
+	// A reference to the sprite sheet texture.
+	sf::Texture const & m_texture;
+
+	// A reference to the grid of wall sprites.
+	WallGrid const & m_walls;
+
+	// The job system that runs the steer phase.
+	JobSystem & m_jobs;
+
+	// The circles around the walls, shared by every AI tank.
+	ObstacleCircles m_obstacles;
+
+	// The open and blocked cells, baked from the walls.
+	NavigationGrid m_navigationGrid;
+
+	// Leads every tank to the player, shared by every AI tank.
+	FlowField m_flowField;
+
+	std::vector<TankAi> m_tanks;
+
+	// Rebuilt by getColliders.
+	std::vector<TankColliders> m_colliders;
+
+	// The number of tanks steered by one job, small enough to balance, large enough to amortise the job overhead.
+	static int const s_TANKS_PER_JOB{ 16 };
+};
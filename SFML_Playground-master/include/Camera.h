@@ -0,0 +1,73 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+/// <summary>
+/// @brief Follows the player around a world that can be larger than the window.
+///
+/// The camera works out where the view is centred for a given target, keeping the view
+/// inside the world so nothing outside it is ever shown. Along an axis where the world is
+/// smaller than the view, the world is centred instead. The camera holds no position of its
+/// own, so the simulation can work out the centre for each update and rendering can blend
+/// between two of them like any other moving object.
+/// Example usage:
+///		Camera camera(sf::Vector2f(ScreenSize::WIDTH, ScreenSize::HEIGHT));
+///		camera.setWorldSize(level.m_world.m_size);
+///		sf::Vector2f centre = camera.getCentre(tank.getPosition());
+///		window.setView(camera.getView(centre));
+/// </summary>
+class Camera
+{
+public:
+	/// <summary>
+	/// @brief Constructor that stores the size of the view, the world is the same size until set.
+	/// </summary>
+	/// <param name="viewSize">The width and height of the area shown in the window, in world units</param>
+	Camera(sf::Vector2f viewSize);
+
+	/// <summary>
+	/// @brief Sets the size of the world the view is kept inside. The world starts at (0, 0).
+	/// </summary>
+	/// <param name="worldSize">The width and height of the world</param>
+	void setWorldSize(sf::Vector2f const & worldSize);
+
+	/// <summary>
+	/// @brief Works out the centre of the view that follows a target, clamped so the view stays inside the world.
+	/// </summary>
+	/// <param name="target">The position to follow, normally the player tank</param>
+	/// <returns>The centre of the view.</returns>
+	sf::Vector2f getCentre(sf::Vector2f target) const;
+
+	/// <summary>
+	/// @brief Gets the part of the world shown by a view.
+	/// </summary>
+	/// <param name="centre">The centre of the view, as returned by getCentre</param>
+	/// <returns>The area in world coordinates.</returns>
+	sf::FloatRect getArea(sf::Vector2f centre) const;
+
+	/// <summary>
+	/// @brief Makes an SFML view to draw the world with.
+	/// </summary>
+	/// <param name="centre">The centre of the view, as returned by getCentre</param>
+	/// <returns>The view.</returns>
+	sf::View getView(sf::Vector2f centre) const;
+
+	/// <summary>
+	/// @brief Gets the size of the view.
+	/// </summary>
+	/// <returns>The width and height of the area shown in the window.</returns>
+	sf::Vector2f const & getViewSize() const;
+
+private:
+	/// <summary>
+	/// @brief Clamps the centre of the view along one axis.
+	/// </summary>
+	/// <param name="target">The position to follow along the axis</param>
+	/// <param name="view">The size of the view along the axis</param>
+	/// <param name="world">The size of the world along the axis</param>
+	/// <returns>The centre of the view along the axis.</returns>
+	static float clampAxis(float target, float view, float world);
+
+	sf::Vector2f m_viewSize;
+	sf::Vector2f m_worldSize;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "SpriteBatch.h"
+
+/// <summary>
+/// @brief Static sprites split into one sprite batch per square chunk of the world, so only
+///  the chunks in view are drawn.
+///
+/// A single batch of every wall costs the same to draw wherever the camera is, which is
+/// fine while the world fits in the window but wasteful for a world many screens across.
+/// Each sprite goes into the chunk that contains its position, and drawing grows the area
+/// in view by the largest sprite's half size so a sprite reaching in from a neighbouring
+/// chunk is still drawn. The sprites must not move after build, like the walls.
+/// Example usage:
+///		walls.setTexture(atlas);
+///		walls.build(wallSprites, worldSize);
+///		walls.render(window, camera.getArea(centre)); //every frame
+/// </summary>
+class ChunkedSpriteBatch
+{
+public:
+	/// <summary>
+	/// @brief Sets the texture shared by every sprite.
+	/// </summary>
+	/// <param name="texture">A reference to the texture</param>
+	void setTexture(sf::Texture const & texture);
+
+	/// <summary>
+	/// @brief Sorts the sprites into chunks, replacing whatever was built before.
+	/// Sprites outside the world go into the nearest chunk along its edge.
+	/// </summary>
+	/// <param name="sprites">The sprites, assumed to use the texture</param>
+	/// <param name="worldSize">The width and height of the world, which starts at (0, 0)</param>
+	/// <param name="chunkSize">The width and height of a chunk in pixels</param>
+	void build(std::vector<sf::Sprite> const & sprites, sf::Vector2f const & worldSize, float chunkSize = s_DEFAULT_CHUNK_SIZE);
+
+	/// <summary>
+	/// @brief Draws the chunks that overlap an area, one draw call per chunk that has sprites.
+	/// </summary>
+	/// <param name="target">The render target, with its view already set</param>
+	/// <param name="area">The part of the world being drawn</param>
+	void render(sf::RenderTarget & target, sf::FloatRect const & area) const;
+
+	/// <summary>
+	/// @brief Gets the total number of sprites in every chunk.
+	/// </summary>
+	/// <returns>The sprite count.</returns>
+	int getSpriteCount() const;
+
+private:
+	// Large enough that a screen covers only a few chunks, so drawing stays a handful of calls.
+	static constexpr float s_DEFAULT_CHUNK_SIZE{ 512.0f };
+
+	// One batch per chunk, row by row.
+	std::vector<SpriteBatch> m_chunks;
+
+	// The chunk dimensions in chunks.
+	int m_columns{ 0 };
+	int m_rows{ 0 };
+
+	// The width and height of a chunk.
+	float m_chunkSize{ s_DEFAULT_CHUNK_SIZE };
+
+	// Half the width and height of the largest sprite bounds.
+	sf::Vector2f m_maxHalfSize;
+
+	// The texture shared by every sprite.
+	sf::Texture const * m_texture{ nullptr };
+};
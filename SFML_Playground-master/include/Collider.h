@@ -0,0 +1,51 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "OrientedBoundingBox.h"
+
+/// <summary>
+/// @brief A lightweight, non-owning view of a rectangular collision shape.
+/// 
+/// Holds a pointer to a transform (usually the one cached inside a sprite) and the local
+/// size of the rectangle, so passing a collider around never copies a sprite. A collider made
+/// from a sprite is only valid while that sprite exists and has not moved, so colliders are
+/// made when they are needed and are not stored.
+/// </summary>
+class Collider
+{
+public:
+	/// <summary>
+	/// @brief Makes a view of a sprite's current transform and texture rectangle size.
+	/// </summary>
+	/// <param name="sprite">The sprite, which must outlive the collider</param>
+	Collider(sf::Sprite const & sprite);
+
+	/// <summary>
+	/// @brief Makes a view of a transform and a local size.
+	/// </summary>
+	/// <param name="transform">The transform, which must outlive the collider</param>
+	/// <param name="size">The width and height of the rectangle before it is transformed</param>
+	Collider(sf::Transform const & transform, sf::Vector2f const & size);
+
+	/// <summary>
+	/// @brief Builds the oriented bounding box of the collider.
+	/// </summary>
+	/// <returns>The bounding box in world coordinates.</returns>
+	OrientedBoundingBox getBox() const;
+
+private:
+	// The transform from local to world coordinates.
+	sf::Transform const * m_transform;
+
+	// The local width and height.
+	sf::Vector2f m_size;
+};
+
+/// <summary>
+/// @brief The colliders of a tank's base and turret.
+/// </summary>
+struct TankColliders
+{
+	Collider m_base;
+	Collider m_turret;
+};
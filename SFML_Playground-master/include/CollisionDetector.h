@@ -20,4 +20,46 @@ class CollisionDetector
 {
 public:
 	bool static collision(const sf::Sprite& object1, const sf::Sprite& object2);
+
+	/// <summary>
+	/// @brief Tests two precomputed bounding boxes for overlap.
+	/// Boxes whose axis aligned bounds do not overlap are rejected before the full SAT test.
+	/// Use this overload in loops, building each box once rather than once per test.
+	/// </summary>
+	bool static collision(const OrientedBoundingBox& OBB1, const OrientedBoundingBox& OBB2);
+
+	/// <summary>
+	/// @brief Tests a box moving in a straight line against a still box (swept SAT).
+	/// The same four axes as collision() are used, and on each the moving box's projection
+	/// slides along with the movement, giving the part of the move in which the projections
+	/// overlap. The boxes touch while all four parts overlap, so the test is exact however
+	/// far the box moves, and a thin box cannot be stepped over.
+	/// </summary>
+	/// <param name="Moving">The moving box at the start of the move</param>
+	/// <param name="Movement">How far the box moves</param>
+	/// <param name="Still">The box that does not move</param>
+	/// <param name="Time">Set to when the boxes first touch, from 0 at the start of the move to 1 at the end</param>
+	/// <returns>True if the boxes touch at any point during the move.</returns>
+	bool static sweep(const OrientedBoundingBox& Moving, const sf::Vector2f& Movement, const OrientedBoundingBox& Still, float& Time);
+
+	/// <summary>
+	/// @brief Tests a line segment against a box (a slab test).
+	/// Along each of the box's two axes the segment is inside the box's projection for one
+	/// part of its length, and it crosses the box where both parts overlap. The segment is a
+	/// point sweeping over the box, so this is sweep() with only the box's axes to test.
+	/// </summary>
+	/// <param name="Origin">The start of the segment</param>
+	/// <param name="Ray">The segment, from its start to its end</param>
+	/// <param name="Box">The box to test</param>
+	/// <param name="Time">Set to where the segment first enters the box, from 0 at its start to 1 at its end</param>
+	/// <returns>True if the segment touches the box.</returns>
+	bool static rayCast(const sf::Vector2f& Origin, const sf::Vector2f& Ray, const OrientedBoundingBox& Box, float& Time);
+
+	/// <summary>
+	/// @brief Gets the axis aligned rectangle a box passes over during a move.
+	/// </summary>
+	/// <param name="Moving">The moving box at the start of the move</param>
+	/// <param name="Movement">How far the box moves</param>
+	/// <returns>The rectangle enclosing the box at the start and the end of the move.</returns>
+	sf::FloatRect static sweptBounds(const OrientedBoundingBox& Moving, const sf::Vector2f& Movement);
 };
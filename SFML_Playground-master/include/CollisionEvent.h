@@ -0,0 +1,92 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// @brief One projectile hit: who fired it, what it hit, where and when.
+///
+/// Tanks are identified by their index in the AiTankManager, or by PLAYER for the player tank.
+/// A projectile that hit a wall has the wall's index in the WallGrid and no victim, and one
+/// that hit a tank has a victim and no wall.
+/// </summary>
+struct CollisionEvent
+{
+	// The shooter or victim id of the player tank.
+	static constexpr int PLAYER{ -1 };
+
+	// The victim of a wall hit, or the wall of a tank hit.
+	static constexpr int NONE{ -2 };
+
+	int m_shooter;
+	int m_victim;
+	int m_wall;
+
+	// Where the projectile was when it hit.
+	sf::Vector2f m_point;
+
+	// The simulation update the hit happened in.
+	std::uint32_t m_tick;
+};
+
+/// <summary>
+/// @brief The hits of one simulation update, stored one after another.
+///
+/// Projectile pools append a CollisionEvent for every projectile they remove on a hit, and the
+/// game then applies damage (and anything else that reacts to hits) in one pass over the
+/// buffer. The storage is allocated up front and kept when the buffer is cleared, so a busy
+/// update only allocates if it has more hits than any update before it.
+/// Example usage:
+///		CollisionEventBuffer events;
+///		events.clear();
+///		pool.update(dt, walls, targets, CollisionEvent::PLAYER, tick, events);
+///		for (CollisionEvent const & event : events) { ... }
+/// </summary>
+class CollisionEventBuffer
+{
+public:
+	/// <summary>
+	/// @brief Constructor that allocates room for a number of events.
+	/// </summary>
+	/// <param name="capacity">The number of events stored before the buffer has to grow</param>
+	CollisionEventBuffer(int capacity = s_DEFAULT_CAPACITY);
+
+	/// <summary>
+	/// @brief Removes every event, keeping the storage.
+	/// </summary>
+	void clear();
+
+	/// <summary>
+	/// @brief Adds an event to the end of the buffer.
+	/// </summary>
+	/// <param name="event">The event</param>
+	void add(CollisionEvent const & event);
+
+	/// <summary>
+	/// @brief Adds every event of another buffer to the end of this one, in order.
+	/// </summary>
+	/// <param name="events">The events to add</param>
+	void append(CollisionEventBuffer const & events);
+
+	/// <summary>
+	/// @brief Gets the number of events.
+	/// </summary>
+	/// <returns>The event count.</returns>
+	int getCount() const;
+
+	std::vector<CollisionEvent>::const_iterator begin() const;
+	std::vector<CollisionEvent>::const_iterator end() const;
+
+	/// <summary>
+	/// @brief Gets one event.
+	/// </summary>
+	/// <param name="index">The event index, in the order the events were added</param>
+	/// <returns>A reference to the event.</returns>
+	CollisionEvent & operator[](int index);
+
+private:
+	static const int s_DEFAULT_CAPACITY = 64;
+
+	std::vector<CollisionEvent> m_events;
+};
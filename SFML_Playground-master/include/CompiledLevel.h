@@ -0,0 +1,190 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "LevelLoader.h"
+
+/// <summary>
+/// @brief A read-only view of a contiguous array that does not own its elements.
+/// </summary>
+template <typename T>
+class ArrayView
+{
+public:
+	ArrayView() = default;
+	ArrayView(T const * data, std::size_t size) : m_data(data), m_size(size) {}
+
+	T const * begin() const { return m_data; }
+	T const * end() const { return m_data + m_size; }
+	T const & operator[](std::size_t index) const { return m_data[index]; }
+	std::size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+
+private:
+	T const * m_data{ nullptr };
+	std::size_t m_size{ 0 };
+};
+
+/// The records below are stored in the file exactly as laid out here (little endian,
+///  4 byte fields), so they can be read straight from the mapped memory.
+
+/// <summary>
+/// @brief A string stored in the file as a byte offset and length, without a terminator.
+/// </summary>
+struct CompiledString
+{
+	std::uint32_t m_offset;
+	std::uint32_t m_length;
+};
+
+/// <summary>
+/// @brief An array of records stored in the file as a byte offset and element count.
+/// </summary>
+struct CompiledSection
+{
+	std::uint32_t m_offset;
+	std::uint32_t m_count;
+};
+
+struct CompiledTank
+{
+	float m_x;
+	float m_y;
+};
+
+struct CompiledSize
+{
+	float m_width;
+	float m_height;
+};
+
+struct CompiledObstacle
+{
+	// Index into the obstacle type names.
+	std::uint32_t m_type;
+	float m_x;
+	float m_y;
+	float m_rotation;
+};
+
+struct CompiledTarget
+{
+	float m_x;
+	float m_y;
+	float m_randomOffset;
+	float m_rotation;
+	std::int32_t m_spawnTime;
+};
+
+/// <summary>
+/// @brief The first bytes of a compiled level file, locating every other section.
+/// </summary>
+struct CompiledLevelHeader
+{
+	char m_magic[4];
+	std::uint32_t m_version;
+	CompiledString m_background;
+	CompiledSize m_world;
+	CompiledTank m_tank;
+	// An array of CompiledString, one per obstacle type.
+	CompiledSection m_typeNames;
+	CompiledSection m_obstacles;
+	CompiledSection m_targets;
+	CompiledSection m_aiTanks;
+};
+
+/// <summary>
+/// @brief A level compiled to a flat binary file, loaded by memory-mapping it.
+/// 
+/// YAML stays the format levels are written in. LevelLoader::compile turns a level file
+/// into a compiled file once, and opening the compiled file only maps it into memory and
+/// checks the header, so there is no parsing and no allocation per obstacle or target.
+/// The obstacles, targets and AI tanks are exposed as views straight into the mapping,
+/// which stay valid until the level is closed or destroyed.
+/// Example usage:
+///		CompiledLevel level;
+///		level.open(".//resources//levels//level1.bin");
+///		for (CompiledObstacle const& obstacle : level.getObstacles()) { ... }
+/// </summary>
+class CompiledLevel
+{
+public:
+	CompiledLevel() = default;
+
+	/// <summary>
+	/// @brief Destructor that unmaps the file.
+	/// </summary>
+	~CompiledLevel();
+
+	CompiledLevel(CompiledLevel const &) = delete;
+	CompiledLevel & operator=(CompiledLevel const &) = delete;
+
+	/// <summary>
+	/// @brief Memory-maps a compiled level file and checks its header.
+	/// If the file cannot be mapped, or is not a compiled level of the current version,
+	///  an exception is thrown.
+	/// </summary>
+	/// <param name="fileName">The path of the compiled level file</param>
+	void open(std::string const & fileName);
+
+	/// <summary>
+	/// @brief Unmaps the file, invalidating every view.
+	/// </summary>
+	void close();
+
+	/// <summary>
+	/// @brief Writes level data as a compiled level file.
+	/// An exception is thrown if the file cannot be written.
+	/// </summary>
+	/// <param name="level">The level data to compile</param>
+	/// <param name="fileName">The path of the compiled level file</param>
+	static void write(LevelData const & level, std::string const & fileName);
+
+	/// <summary>
+	/// @brief Copies the compiled level into level data, for code that needs a LevelData.
+	/// Every container is sized once up front.
+	/// </summary>
+	/// <param name="level">A reference to the LevelData object</param>
+	void toLevelData(LevelData & level) const;
+
+	std::string getBackground() const;
+	CompiledSize const & getWorld() const;
+	CompiledTank const & getTank() const;
+	ArrayView<CompiledObstacle> getObstacles() const;
+	ArrayView<CompiledTarget> getTargets() const;
+	ArrayView<CompiledTank> getAiTanks() const;
+
+	/// <summary>
+	/// @brief Gets the name of an obstacle type.
+	/// </summary>
+	/// <param name="type">The type index of an obstacle</param>
+	/// <returns>The type name, e.g. "wall".</returns>
+	std::string getTypeName(std::uint32_t type) const;
+
+	// Increased whenever the layout of the records changes.
+	static std::uint32_t const s_VERSION{ 2 };
+
+private:
+	/// <summary>
+	/// @brief Gets the records of a section as a view into the mapping.
+	/// </summary>
+	template <typename T>
+	ArrayView<T> getSection(CompiledSection const & section) const
+	{
+		return ArrayView<T>(reinterpret_cast<T const *>(m_data + section.m_offset), section.m_count);
+	}
+
+	/// <summary>
+	/// @brief Throws if a section or string lies outside the mapped file.
+	/// </summary>
+	void checkRange(std::uint32_t offset, std::uint64_t bytes) const;
+
+	CompiledLevelHeader const & getHeader() const;
+
+	// The start of the mapped file, or nullptr when closed.
+	char const * m_data{ nullptr };
+
+	// The size of the mapped file in bytes.
+	std::size_t m_size{ 0 };
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+
+/// <summary>
+/// @brief The stream ids of everything in the simulation that draws random numbers.
+/// Each drawer has its own stream, so no two of them ever get the same numbers.
+/// </summary>
+namespace RandomStream
+{
+	std::uint32_t const PLAYER{ 1 };
+	std::uint32_t const TARGETS{ 2 };
+	std::uint32_t const EXTRA_WALLS{ 3 };
+
+	// AI tank i draws from stream AI_TANKS + i.
+	std::uint32_t const AI_TANKS{ 0x10000 };
+}
+
+/// <summary>
+/// @brief A counter-based random number generator: every number is a hash of the seed,
+///  a stream id, a counter and an index.
+///
+/// Nothing changes when a number is drawn, so any number of threads can draw at once without
+/// locks, and the numbers an entity gets do not depend on what other entities drew before it
+/// or on the order they are updated in. The stream is the entity drawing (see RandomStream),
+/// the counter is normally the simulation tick, and the index separates the draws the entity
+/// makes within one tick. The same seed gives the same numbers on every run, so a game
+/// played again with its seed and input draws exactly the same numbers.
+/// Example usage:
+///		CounterRandom random(seed);
+///		int x = random.getInt(ScreenSize::WIDTH, RandomStream::AI_TANKS + index, tick, 0);
+///		int y = random.getInt(ScreenSize::HEIGHT, RandomStream::AI_TANKS + index, tick, 1);
+/// </summary>
+class CounterRandom
+{
+public:
+	/// <summary>
+	/// @brief Constructor that stores the seed.
+	/// </summary>
+	/// <param name="seed">The seed all numbers are derived from</param>
+	CounterRandom(std::uint32_t seed = 0);
+
+	/// <summary>
+	/// @brief Gets the seed.
+	/// </summary>
+	/// <returns>The seed.</returns>
+	std::uint32_t getSeed() const;
+
+	/// <summary>
+	/// @brief Gets the random number for a stream, counter and index.
+	/// </summary>
+	/// <param name="stream">The id of whatever is drawing the number</param>
+	/// <param name="counter">Normally the simulation tick</param>
+	/// <param name="index">Which of the numbers drawn for the same stream and counter</param>
+	/// <returns>A number uniformly spread over the whole 32 bit range.</returns>
+	std::uint32_t get(std::uint32_t stream, std::uint32_t counter, std::uint32_t index = 0) const;
+
+	/// <summary>
+	/// @brief Gets a random number in [0, bound) for a stream, counter and index.
+	/// </summary>
+	/// <param name="bound">One past the largest number wanted, 0 always gives 0</param>
+	/// <param name="stream">The id of whatever is drawing the number</param>
+	/// <param name="counter">Normally the simulation tick</param>
+	/// <param name="index">Which of the numbers drawn for the same stream and counter</param>
+	/// <returns>A number from 0 to bound - 1.</returns>
+	int getInt(int bound, std::uint32_t stream, std::uint32_t counter, std::uint32_t index = 0) const;
+
+private:
+	/// <summary>
+	/// @brief The SplitMix64 finaliser, which spreads every input bit over every output bit.
+	/// </summary>
+	static std::uint64_t mix(std::uint64_t value);
+
+	std::uint32_t m_seed;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+
+/// <summary>
+/// @brief The kinds of visual effect the simulation asks for.
+/// </summary>
+enum class EffectType
+{
+	MUZZLE_FLASH,
+	WALL_IMPACT,
+	TANK_IMPACT,
+	DUST
+};
+
+/// <summary>
+/// @brief A visual effect to start, recorded by the simulation and played by the EffectSystem.
+///
+/// Effects never change the game, so the simulation only records what happened and where,
+/// and the effects are played on the render side with their own random numbers.
+/// </summary>
+struct EffectEvent
+{
+	EffectType m_type;
+
+	// Where the effect starts.
+	sf::Vector2f m_position;
+
+	// The direction the effect points in degrees, such as the direction a shot was fired.
+	float m_rotation;
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <random>
+#include "EffectEvent.h"
+#include "ParticlePool.h"
+
+/// <summary>
+/// @brief Plays muzzle flashes, impacts and tank dust as particles.
+///
+/// Every particle lives in one ParticlePool whose size is the particle budget, so the
+/// effects never allocate once the game is running and draw with a single draw call from
+/// the texture atlas. When more than half of the budget is in use each new effect emits
+/// fewer particles, in proportion to the room left, so a busy fight thins the effects out
+/// gradually instead of dropping new effects outright when the pool fills up.
+/// Effects are only visual, so they use their own random numbers and never touch the
+/// simulation's.
+/// Example usage:
+///		EffectSystem effects(4096);
+///		effects.setTexture(atlas, sparksRect, dustRect);
+///		effects.emit(EffectEvent{ EffectType::MUZZLE_FLASH, position, rotation });
+///		effects.update(seconds);
+///		window.draw(effects);
+/// </summary>
+class EffectSystem : public sf::Drawable
+{
+public:
+	/// <summary>
+	/// @brief Constructor that allocates the particle budget.
+	/// </summary>
+	/// <param name="budget">The maximum number of live particles</param>
+	EffectSystem(int budget);
+
+	/// <summary>
+	/// @brief Sets the texture the particles are drawn from, and the areas of it each effect uses.
+	/// </summary>
+	/// <param name="texture">A reference to the texture, normally the resource cache's atlas</param>
+	/// <param name="sparks">The area of the texture with the spark image</param>
+	/// <param name="dust">The area of the texture with the dust image</param>
+	void setTexture(sf::Texture const & texture, sf::IntRect const & sparks, sf::IntRect const & dust);
+
+	/// <summary>
+	/// @brief Starts an effect, with fewer particles when the budget is running out.
+	/// </summary>
+	/// <param name="event">The effect to start</param>
+	void emit(EffectEvent const & event);
+
+	/// <summary>
+	/// @brief Moves, fades and removes the particles of every effect.
+	/// </summary>
+	/// <param name="seconds">The time since the last update</param>
+	void update(float seconds);
+
+	/// <summary>
+	/// @brief Removes every particle.
+	/// </summary>
+	void clear();
+
+	/// <summary>
+	/// @brief Gets the number of live particles.
+	/// </summary>
+	/// <returns>The live particle count.</returns>
+	int getParticleCount() const;
+
+private:
+	/// <summary>
+	/// @brief Emits a burst of particles spreading out around a direction.
+	/// </summary>
+	/// <param name="style">The particle style index</param>
+	/// <param name="position">Where the particles start</param>
+	/// <param name="direction">The centre of the spread in degrees</param>
+	/// <param name="spread">The total angle of the spread in degrees</param>
+	/// <param name="minSpeed">The slowest starting speed in pixels per second</param>
+	/// <param name="maxSpeed">The fastest starting speed in pixels per second</param>
+	/// <param name="lifetime">How long the longest lived particles live in seconds</param>
+	/// <param name="count">The number of particles with the whole budget free</param>
+	void burst(int style, sf::Vector2f const & position, float direction, float spread,
+		float minSpeed, float maxSpeed, float lifetime, int count);
+
+	/// <summary>
+	/// @brief Scales a burst's particle count down as the budget fills up.
+	/// </summary>
+	/// <param name="count">The number of particles with the whole budget free</param>
+	/// <returns>The number of particles to emit.</returns>
+	int scaleCount(int count) const;
+
+	/// <summary>
+	/// @brief Draws every particle with one draw call.
+	/// </summary>
+	virtual void draw(sf::RenderTarget & target, sf::RenderStates states) const override;
+
+	ParticlePool m_particles;
+
+	// The particle style indices of each kind of effect.
+	int m_flashStyle{ 0 };
+	int m_sparkStyle{ 0 };
+	int m_hitStyle{ 0 };
+	int m_dustStyle{ 0 };
+	int m_smokeStyle{ 0 };
+
+	// Random directions, speeds and lifetimes for the particles.
+	std::minstd_rand m_random;
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "NavigationGrid.h"
+
+/// <summary>
+/// @brief A field of directions over the navigation grid that leads every cell to a goal.
+/// 
+/// The field is built by a breadth-first search outwards from the goal cell through the 
+/// open cells, then each cell points at its neighbour closest to the goal. Sampling the
+/// field is a single array lookup, so any number of tanks can follow it for the same cost.
+/// The search is incremental: update() expands, and then points, a number of cells per call
+/// into a second set of arrays, and the finished field only replaces the one being sampled
+/// when every cell has been pointed. A goal set while a search is running is picked up by the next one. The number
+/// of cells per call grows with the grid, so a search takes about the same number of updates
+/// however large the world is, and tanks never follow a field more than that far out of date.
+/// </summary>
+class FlowField
+{
+public:
+	/// <summary>
+	/// @brief Constructor that stores a reference to the navigation grid.
+	/// </summary>
+	/// <param name="grid">A reference to the navigation grid</param>
+	FlowField(NavigationGrid const & grid);
+
+	/// <summary>
+	/// @brief Discards both fields and sizes them, and the cells expanded per update, to the navigation grid.
+	/// Must be called whenever the navigation grid is rebuilt.
+	/// </summary>
+	void reset();
+
+	/// <summary>
+	/// @brief Sets the position the field leads to.
+	/// </summary>
+	/// <param name="position">The goal in world coordinates</param>
+	void setGoal(sf::Vector2f position);
+
+	/// <summary>
+	/// @brief Continues building the field, starting a new search if the goal has moved.
+	/// Expands enough cells that a search over the whole grid takes s_UPDATES_PER_SEARCH calls.
+	/// </summary>
+	void update();
+
+	/// <summary>
+	/// @brief Continues building the field, starting a new search if the goal has moved.
+	/// Expanding a cell and pointing a cell each take one from the budget.
+	/// </summary>
+	/// <param name="cellBudget">The largest number of cells to expand or point in this call</param>
+	void update(int cellBudget);
+
+	/// <summary>
+	/// @brief Gets the number of cells update() expands or points per call.
+	/// </summary>
+	/// <returns>The cell budget, set by reset().</returns>
+	int getCellsPerUpdate() const;
+
+	/// <summary>
+	/// @brief Gets the direction to travel from a position towards the goal.
+	/// </summary>
+	/// <param name="position">A position in world coordinates</param>
+	/// <returns>A unit vector, or (0,0) in the goal cell, in cells with no path or before the first field is ready.</returns>
+	sf::Vector2f getDirection(sf::Vector2f position) const;
+
+	/// <summary>
+	/// @brief Builds the whole field at once, for when a level starts.
+	/// </summary>
+	/// <param name="position">The goal in world coordinates</param>
+	void buildNow(sf::Vector2f position);
+
+private:
+	/// <summary>
+	/// @brief Starts a new search from the goal cell.
+	/// </summary>
+	void startSearch();
+
+	/// <summary>
+	/// @brief Points the next cells of the finished search at their neighbour closest to the goal,
+	///  and makes it the field that is sampled once the last cell is pointed.
+	/// </summary>
+	/// <param name="cellBudget">The largest number of cells to point</param>
+	void pointCells(int cellBudget);
+
+	// A cell the search has not reached.
+	static constexpr int s_UNREACHED{ -1 };
+
+	// The number of updates a search over the whole grid takes, 50 ms at the fixed step.
+	static int const s_UPDATES_PER_SEARCH{ 5 };
+
+	// A search passes over the cells twice, once expanding them and once pointing them.
+	static int const s_PASSES_PER_SEARCH{ 2 };
+
+	// The fewest cells expanded or pointed per update, so a one screen world still searches in a few updates.
+	static int const s_MIN_CELLS_PER_UPDATE{ 512 };
+
+	// The number of cells update() expands or points per call, set by reset().
+	int m_cellsPerUpdate{ s_MIN_CELLS_PER_UPDATE };
+
+	// A reference to the navigation grid.
+	NavigationGrid const & m_grid;
+
+	// The goal cell of the latest setGoal, and of the search in progress.
+	int m_goalCell{ -1 };
+	int m_searchGoalCell{ -1 };
+
+	// True while a search is in progress.
+	bool m_searching{ false };
+
+	// The distance in cells of each cell from the goal, for the search in progress.
+	std::vector<int> m_distance;
+
+	// The cells waiting to be expanded, from m_queueHead onwards.
+	std::vector<int> m_queue;
+	std::size_t m_queueHead{ 0 };
+
+	// The number of cells pointed so far, once the queue is empty.
+	int m_pointedCells{ 0 };
+
+	// The direction of each cell, for the search in progress and for the finished field.
+	std::vector<sf::Vector2f> m_nextDirections;
+	std::vector<sf::Vector2f> m_directions;
+};
@@ -3,11 +3,35 @@
 #include <SFML/Graphics.hpp>
 #include "ScreenSize.h"
 #include "LevelLoader.h"
+#include "LevelManager.h"
 #include "Tank.h"
 #include <fstream>
-#include "TankAI.h"
+#include "AiTankManager.h"
+#include "JobSystem.h"
 #include "GameState.h"
 #include "HUD.h"
+#include "InputState.h"
+#include "SimulationClock.h"
+#include "GameSettings.h"
+#include "WallGrid.h"
+#include "SpriteBatch.h"
+#include "ChunkedSpriteBatch.h"
+#include "Camera.h"
+#include "StaticLayer.h"
+#include "Profiler.h"
+#include "ProfilerOverlay.h"
+#include "ScoreTable.h"
+#include "RenderSnapshot.h"
+#include "TripleBuffer.h"
+#include "ResourceCache.h"
+#include "CollisionEvent.h"
+#include "EffectSystem.h"
+#include "InputLog.h"
+#include "StateHash.h"
+#include "CounterRandom.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 /// <summary>
 /// @author RP
@@ -31,21 +55,54 @@ public:
 	/// <summary>
 	/// @brief Default constructor that initialises the SFML window, 
 	///   and sets vertical sync enabled. 
+	/// In headless mode no window is created and no textures or fonts are loaded,
+	///  so the simulation can run on machines without a display.
 	/// </summary>
-	Game();
+	/// <param name="settings">Options for the window, random seed and level</param>
+	Game(GameSettings const& settings = GameSettings());
 
 	/// <summary>
 	/// @brief the main game loop.
 	/// 
 	/// A complete loop involves processing SFML events, updating and drawing all game objects.
-	/// The actual elapsed time for a single game loop results (lag) is stored. If this value is 
-	///  greater than the notional time for one loop (MS_PER_UPDATE), then additional updates will be 
-	///  performed until the lag is less than the notional time for one loop.
-	/// The target is one update and one render cycle per game loop, but slower PCs may 
-	///  perform more update than render operations in one loop.
+	/// The elapsed time of each loop is added to the time not yet simulated (lag), and fixed
+	///  updates of MS_PER_UPDATE are performed while a whole update's worth is left, so the
+	///  simulation runs at the same rate on every PC. A fast PC draws several frames per update,
+	///  a slow one performs several updates per frame. The frame time added is capped at
+	///  MAX_FRAME_MS so a stall cannot snowball into ever more updates per frame.
+	/// The remaining lag is passed to render, which draws the moving objects that far between
+	///  the previous and the latest update, so the motion stays smooth at any refresh rate.
+	/// With GameSettings::m_simulationThread the updates run on their own thread instead (see runThreaded).
 	/// </summary>
 	void run();
 
+	/// <summary>
+	/// @brief Advances the simulation by one fixed update step using the supplied input.
+	/// Does not poll events or render, so it can be called in a tight loop by a headless driver.
+	/// </summary>
+	/// <param name="input">The controls held down for this step</param>
+	void step(InputState const& input);
+
+	/// <summary>
+	/// @brief Gets the fixed simulation step in milliseconds.
+	/// </summary>
+	/// <returns>The time simulated by a single call to update.</returns>
+	static double getUpdateStep();
+
+	/// <summary>
+	/// @brief Gets the number of wall sprites in the current level.
+	/// </summary>
+	/// <returns>The wall count.</returns>
+	int getWallCount() const;
+
+	/// <summary>
+	/// @brief Hashes everything the simulation's future depends on: the tanks, their projectiles,
+	///  the targets, the time and the score.
+	/// Two games given the same settings and input end with the same hash, bit for bit.
+	/// </summary>
+	/// <returns>The StateHash value of the current state.</returns>
+	std::uint64_t getStateHash() const;
+
 protected:
 	/// <summary>
 	/// @brief Placeholder to perform updates to all game objects.
@@ -56,8 +113,44 @@ protected:
 	/// <summary>
 	/// @brief Draws the background and foreground game objects in the SFML window.
 	/// The render window is always cleared to black before anything is drawn.
+	/// Sprites are drawn through sprite batches (one per texture), so a frame takes the same
+	///  handful of draw calls however many walls, targets and projectiles there are.
+	/// The world is drawn through a view that follows the player, and only what the snapshot
+	///  holds near the camera is drawn. The background and walls never move, so they are drawn
+	///  from a cache of tiles painted once (see StaticLayer), under everything else. The HUD and
+	///  text are drawn with the window's default view, so they stay put.
+	/// Only the snapshot is read, never the simulation, so rendering can run while the simulation updates.
 	/// </summary>
-	void render();
+	/// <param name="snapshot">The simulation state to draw</param>
+	/// <param name="alpha">How far from the previous update to the latest one to draw the tanks and projectiles, 0 to 1</param>
+	void render(RenderSnapshot const& snapshot, float alpha);
+
+	/// <summary>
+	/// @brief Copies what render needs from the simulation into a snapshot.
+	/// Only the tanks, projectiles, vision cones and targets near the camera are copied.
+	/// </summary>
+	/// <param name="snapshot">The snapshot to fill, reusing its storage</param>
+	void fillSnapshot(RenderSnapshot& snapshot);
+
+	/// <summary>
+	/// @brief The main loop when the simulation has its own thread.
+	/// The main thread handles events, samples the keyboard for the simulation and draws the
+	///  latest snapshot, so waiting for vsync never holds up an update. The snapshot is drawn
+	///  blending towards its latest update over one update step from when it was published.
+	/// </summary>
+	void runThreaded();
+
+	/// <summary>
+	/// @brief The simulation thread's loop, which updates at a fixed rate and publishes a snapshot after each update.
+	/// If the thread falls more than MAX_FRAME_MS behind, the lost time is dropped instead of caught up.
+	/// </summary>
+	void runSimulation();
+
+	/// <summary>
+	/// @brief Draws something in the window and counts the draw call for the profiler.
+	/// </summary>
+	/// <param name="drawable">The object to draw</param>
+	void draw(sf::Drawable const& drawable);
 
 	/// <summary>
 	/// @brief Checks for events.
@@ -76,52 +169,124 @@ protected:
 	/// @brief Creates the wall sprites and loads them into a vector.
 	/// Note that sf::Sprite is considered a light weight class, so
 	/// storing copies (instead od pointers to sf::Sprite) in std::vector is acceptable.
+	/// The wall grid is then built so collision checks only test nearby walls, and a copy of
+	/// the walls is published for render, which sorts it into chunks on the main thread (see
+	/// rebuildStaticLayer), so the simulation never changes what render is drawing.
 	/// </summary>
 	void generateWalls();
 
 	//generate targets and put them into a vector
 	void generateTargets();
 
-	//function to save the player scores
+	//function to add the player score to the score table, once per game
 	void saveScores();
 
-	//function to get the player scores
-	void getScores();
+	//function to show the score table from a snapshot, the text is only rebuilt when the table has changed
+	void getScores(RenderSnapshot const& snapshot);
 
 	//function to restart the game
 	void restartGame();
 
+	//swaps in the preloaded next level and restarts on it, or restarts this level if the next is not ready
+	void nextLevel();
+
+	//starts loading the snapshot's backgrounds, and shows the current one once it has loaded
+	void loadBackgrounds(RenderSnapshot const& snapshot);
+
+	//rebuilds the wall chunks from the snapshot's walls and repaints the static layer, if the walls have been generated again
+	void rebuildStaticLayer(RenderSnapshot const& snapshot);
+
+	//applies the damage of every projectile hit in this update, in one pass over the collision events
+	void applyCollisionEvents();
+
+	//hands the effects started in this update, and the impacts of its collision events, to the main thread
+	void publishEffects();
+
+	//plays the effects published since the last frame near the area in view, then moves the particles on by the time since the last frame
+	void playEffects(sf::FloatRect const& area);
+
+	//adds randomly placed walls across the level's world (see GameSettings::m_extraWalls)
+	void generateExtraWalls(int count);
+
+	//saves the recorded input and final state hash, when recording (see GameSettings::m_recordFile)
+	void saveInputLog();
+
+	//the options this game was created with
+	GameSettings m_settings;
 
 	// main window
 	sf::RenderWindow m_window;
+
+	//total simulated time, advanced by the fixed step in every update
+	sf::Time m_simulationTime;
+
+	//the number of updates so far, stored in collision events
+	std::uint32_t m_tick{ 0 };
+
+	//the projectile hits of the current update, refilled every update
+	CollisionEventBuffer m_collisionEvents;
+
+	//the input of every update so far, only kept when recording
+	InputLog m_inputLog;
+
+	//every random number in the simulation comes from here, seeded with m_settings.m_seed
+	CounterRandom m_random;
+
+	//the controls used by the next update
+	InputState m_input;
 	LevelData m_level; //variable for the level
-	sf::Texture m_bgTexture; //variable for the  background texture
-	sf::Sprite m_bgSprite; //background sprite
+	//The level rotation, the next level is loaded in the background while this one is played
+	LevelManager m_levels{ m_settings.m_level };
+	//Every texture and font, each file loaded once and shared
+	ResourceCache m_resources{ !m_settings.m_headless };
+	sf::Sprite m_bgSprite; //background sprite, textured once the background has loaded
+	std::string m_shownBackground; //the background the sprite shows, or is waiting for
+	std::string m_prefetchedBackground; //the next level's background, loaded ahead of time
 	Tank m_tank; //tank object
-	//An instance representing the AI controlled tank
-	TankAi m_aiTank;
-	sf::Texture m_texture; //texture variable
-	sf::Font m_textFont; //font for the game
-	sf::Text m_timerText; //timer text 
-	sf::Clock m_timer; //timer to help controll the game
+	//Threads shared by the parallel parts of the update
+	JobSystem m_jobs;
+	//All of the AI controlled tanks
+	AiTankManager m_aiTanks;
+	SimulationClock m_timer{ m_simulationTime }; //timer to help controll the game
 	int m_time; //time variable to display the remaining time
-	sf::Texture m_targetTexture; //texture variable for the target
 	int m_targetDuration; //target duration variable
-	sf::Clock m_tankTimer;
+	SimulationClock m_tankTimer{ m_simulationTime };
 
-	sf::Text m_healthText; //text variable for the score
-	sf::Text m_accuracyText; //text variable for the accuracy
 
 	//Wall sprites
 	std::vector<sf::Sprite> m_wallSprites;
+	//Broad-phase grid over the wall sprites, rebuilt by generateWalls
+	WallGrid m_wallGrid{ m_wallSprites };
+	//A copy of the wall sprites for render, replaced (never changed) by generateWalls and passed on through the snapshots
+	std::shared_ptr<std::vector<sf::Sprite> const> m_publishedWalls;
+	//Counts the calls to generateWalls, passed to render through the snapshots
+	int m_wallVersion{ 0 };
+	//The published walls in one vertex array per chunk of the world, only used by the main thread
+	ChunkedSpriteBatch m_wallBatch;
+	//The background and walls, painted into tiles once and drawn from them every frame
+	StaticLayer m_staticLayer;
+	//The wall version the wall chunks were built from and the static layer painted with, only used by the main thread
+	int m_paintedWallVersion{ -1 };
+	//Follows the player tank around the world, which can be larger than the window
+	Camera m_camera{ sf::Vector2f(static_cast<float>(ScreenSize::WIDTH), static_cast<float>(ScreenSize::HEIGHT)) };
+	//The world as seen by the camera, set every frame from the snapshot's camera centres
+	sf::View m_view;
+	//How far past the edge of the view things are still copied into a snapshot, enough for a tank
+	//turned any way and for the camera moving between two updates
+	static constexpr float s_CULL_MARGIN{ 100.0f };
+	//Tanks and projectiles, refilled every frame
+	SpriteBatch m_spriteBatch;
+	//The live targets, refilled every frame
+	SpriteBatch m_targetBatch;
 	//target sprites
 	std::vector<sf::Sprite> m_targets;
+	//bounding boxes of the target sprites, targets never move so these are built once
+	std::vector<OrientedBoundingBox> m_targetBoxes;
 	std::vector<sf::Vector2f>m_tankPos; //tank pos
 
 	bool targetsAlive[10] = { false, false, false, false, false, false, false, false, false, false }; //array for the targets alive
 
-	sf::Text m_targetText; //text variable for the alive timer
-	sf::Clock m_aliveTimer; //a clock for the alive timer
+	SimulationClock m_aliveTimer{ m_simulationTime }; //a clock for the alive timer
 	int m_aliveTime; // variable to help display alive time
 
 	sf::Color alpha; //colour variable to control the alpha
@@ -132,9 +297,10 @@ protected:
 
 	float m_accuracy; //float for the accuracy
 
-	std::string m_ScoreBoard; //string for the scoreboard text file location
-	std::string m_scores; //string to get scores into 1 string
-	std::string scores; //string to get text out of the file
+	//The best scores, read from the score log once and appended to in the background
+	ScoreTable m_scoreTable{ ".//resources//data//scores.dat" };
+	int m_scoreVersion{ -1 }; //score table version shown by the message text
+	bool m_scoreSaved{ false }; //whether this game's score has been added to the table
 
 	sf::Text m_message; //text variable
 	sf::Text m_message1; //text variable
@@ -148,16 +314,44 @@ protected:
 	//The initial state set to game running
 	GameState m_gameState{ GameState::GAME_RUNNING };
 
-	//The font used for the hud
-	sf::Font m_font;
+	//The font used for the hud and all other text
+	sf::Font& m_font{ m_resources.getFont(".//resources//fonts//arial.ttf") };
 
 	//The game HUD instance
 	HUD m_hud;
+
+	//Section times and counters, toggled with F3
+	ProfilerOverlay m_profilerOverlay{ m_font };
 	
-	sf::Clock m_restartTimer;
+	SimulationClock m_restartTimer{ m_simulationTime };
 
 	int targetsCollected{ 0 };
 
 	int const MAX_TARGETS{ 10 };
 
+	//Snapshots of the simulation, passed from update to render
+	TripleBuffer<RenderSnapshot> m_snapshots;
+
+	//Set by update when the player asks to exit, the window is closed by the main thread
+	std::atomic<bool> m_exitRequested{ false };
+
+	//The simulation thread, only used with GameSettings::m_simulationThread
+	std::thread m_simulationThread;
+	std::atomic<bool> m_simulationRunning{ false };
+
+	//The latest keyboard state, written by the main thread and read by the simulation thread
+	std::mutex m_inputMutex;
+	InputState m_sharedInput;
+
+	//Muzzle flashes, impacts and dust, played and drawn by the main thread only
+	EffectSystem m_effects{ m_settings.m_particleBudget };
+	sf::Clock m_effectClock; //time since the particles were last updated
+
+	//The effects published by the simulation and not yet played, guarded by m_effectMutex
+	std::mutex m_effectMutex;
+	std::vector<EffectEvent> m_publishedEffects;
+	std::vector<EffectEvent> m_playedEffects; //swapped with the published effects, so neither allocates once warmed up
+	static constexpr std::size_t s_MAX_PUBLISHED_EFFECTS{ 1024 }; //effects beyond this are dropped while the main thread is stalled
+	static constexpr float s_MAX_EFFECT_STEP{ 0.1f }; //the longest time the particles are moved on in one frame, in seconds
+
 };
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+
+/// <summary>
+/// @brief Options that control how a Game instance is created and run.
+/// 
+/// The defaults give the normal windowed game. The headless options are used by the 
+/// simulation benchmark to run Game::update without a display.
+/// </summary>
+struct GameSettings
+{
+	// When true no window is created and no textures or fonts are loaded.
+	bool m_headless{ false };
+
+	// Seed for the random number generator, 0 seeds from the system clock.
+	// The game stores the seed it actually used here.
+	unsigned m_seed{ 0 };
+
+	// The level number to load.
+	int m_level{ 1 };
+
+	// Extra randomly placed walls added to the level (used to scale benchmark load).
+	int m_extraWalls{ 0 };
+
+	// The number of threads that update the AI tanks, 0 uses one per hardware thread.
+	int m_threads{ 0 };
+
+	// When true the profiler starts enabled, instead of waiting for F3.
+	bool m_profile{ false };
+
+	// When true Game::run updates the simulation on its own thread, so rendering never holds it up.
+	bool m_simulationThread{ false };
+
+	// The most particles the muzzle flash, impact and dust effects may have alive at once.
+	int m_particleBudget{ 4096 };
+
+	// When not empty, the input of every update is recorded and saved to this file when the game closes (see InputLog).
+	std::string m_recordFile;
+};
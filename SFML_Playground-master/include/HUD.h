@@ -2,11 +2,28 @@
 
 #include <SFML/Graphics.hpp>
 #include "GameState.h"
+#include "TextBatch.h"
+
+/// <summary>
+/// @brief The values shown on the HUD.
+/// </summary>
+struct HudValues
+{
+	int m_targetsCollected;
+	int m_maxTargets;
+	int m_time;
+	int m_health;
+	int m_accuracy;
+	GameState m_gameState;
+};
 
 /// <summary>
 /// @brief A basic HUD implementation.
-/// 
-/// Shows current game state only.
+///
+/// Shows the current game state, and the targets, time, health and accuracy while the game is running.
+/// The HUD keeps the values it was last given, and only lays its text out again when one of
+/// them has changed, so most frames draw the text exactly as it was. All of the text is laid
+/// out in one TextBatch and drawn with a single draw call.
 /// </summary>
 
 class HUD
@@ -18,26 +35,33 @@ public:
 	HUD(sf::Font& hudFont);
 
 	/// <summary>
-	/// @brief Checks the current game state and sets the appropriate status text on the HUD.
+	/// @brief Stores the values to show, marking the text for layout if any of them changed.
 	/// </summary>
-	/// <param name="gameState">The current game state</param>
-	void update(GameState const& gameState);
+	/// <param name="values">The current HUD values</param>
+	void update(HudValues const& values);
 
 	/// <summary>
-	/// @brief Draws the HUD outline and text.
+	/// @brief Draws the HUD outline and text, laying out the text first if it is out of date.
 	///
 	/// </summary>
 	/// <param name="window">The SFML Render window</param>
 	void render(sf::RenderWindow& window);
 
 private:
-	// The font for this HUD.
-	sf::Font m_textFont;
+	/// <summary>
+	/// @brief Lays out every HUD string from the current values.
+	/// </summary>
+	void layout();
+
+	// The values the text shows, or will show once laid out.
+	HudValues m_values{ 0, 0, 0, 0, 0, GameState::GAME_RUNNING };
 
-	// A container for the current HUD text.
-	sf::Text m_gameStateText;
+	// Whether the values changed since the text was last laid out.
+	bool m_dirty{ true };
+
+	// All of the HUD text.
+	TextBatch m_text;
 
 	// A simple background shape for the HUD.
 	sf::RectangleShape m_hudOutline;
 };
-
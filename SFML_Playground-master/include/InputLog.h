@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "InputState.h"
+
+/// The records below are stored in the file exactly as laid out here (little endian).
+
+/// <summary>
+/// @brief The first bytes of an input log, followed by InputRun records covering m_tickCount updates.
+/// </summary>
+struct InputLogHeader
+{
+	char m_magic[4];
+	std::uint32_t m_version;
+	// The settings that decide how the recorded game plays out.
+	std::uint32_t m_seed;
+	std::int32_t m_level;
+	std::int32_t m_extraWalls;
+	std::uint32_t m_tickCount;
+	// The StateHash of the game after its last recorded update.
+	std::uint64_t m_stateHash;
+};
+
+/// <summary>
+/// @brief The same input held for a number of updates in a row.
+/// </summary>
+struct InputRun
+{
+	// One bit per InputState control, see InputLog::pack.
+	std::uint16_t m_controls;
+	std::uint16_t m_ticks;
+};
+
+/// <summary>
+/// @brief A compact binary recording of the input of every simulation update.
+///
+/// The simulation only reads the keyboard through the InputState of each update, and only
+/// draws random numbers from a CounterRandom seeded with the game's seed, so the seed, the level and
+/// the input of every update are enough to play a game again exactly as it was recorded.
+/// Controls are held for many updates at a time, so the input is stored as runs of the
+/// same controls, which keeps an hour long game to a few kilobytes. The hash of the final
+/// state is stored too, so a replay can check it ended bit for bit the same.
+/// Example usage:
+///		InputLog log;
+///		log.start(seed, 1, 0);
+///		log.record(input); //every update
+///		log.finish(game.getStateHash());
+///		log.save("game.input");
+/// </summary>
+class InputLog
+{
+public:
+	/// <summary>
+	/// @brief Clears the log and stores the settings of the game about to be recorded.
+	/// </summary>
+	/// <param name="seed">The seed the game actually used</param>
+	/// <param name="level">The first level number</param>
+	/// <param name="extraWalls">The number of extra walls added to each level</param>
+	void start(std::uint32_t seed, int level, int extraWalls);
+
+	/// <summary>
+	/// @brief Adds the input of one update.
+	/// </summary>
+	/// <param name="input">The input the update used</param>
+	void record(InputState const & input);
+
+	/// <summary>
+	/// @brief Stores the hash of the game's state after the last recorded update.
+	/// </summary>
+	/// <param name="stateHash">The StateHash value</param>
+	void finish(std::uint64_t stateHash);
+
+	/// <summary>
+	/// @brief Writes the log to a file, replacing it. An exception is thrown if the file cannot be written.
+	/// </summary>
+	/// <param name="fileName">The path of the file</param>
+	void save(std::string const & fileName) const;
+
+	/// <summary>
+	/// @brief Reads a log from a file.
+	/// An exception is thrown if the file cannot be read or is not an input log of the current version.
+	/// </summary>
+	/// <param name="fileName">The path of the file</param>
+	void load(std::string const & fileName);
+
+	/// <summary>
+	/// @brief Gets the header, holding the settings and final state hash of the recorded game.
+	/// </summary>
+	/// <returns>A reference to the header.</returns>
+	InputLogHeader const & getHeader() const;
+
+	/// <summary>
+	/// @brief Gets the recorded input, as runs of updates with the same input.
+	/// </summary>
+	/// <returns>A reference to the runs, in order.</returns>
+	std::vector<InputRun> const & getRuns() const;
+
+	/// <summary>
+	/// @brief Packs the controls of an input state into one bit each.
+	/// </summary>
+	static std::uint16_t pack(InputState const & input);
+
+	/// <summary>
+	/// @brief Unpacks controls packed by pack().
+	/// </summary>
+	static InputState unpack(std::uint16_t controls);
+
+private:
+	static std::uint32_t const s_VERSION{ 1 };
+
+	InputLogHeader m_header{};
+	std::vector<InputRun> m_runs;
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+/// <summary>
+/// @brief A snapshot of the controls that drive the simulation for a single tick.
+/// 
+/// The simulation never queries the keyboard directly. Instead the game samples the
+/// keyboard once per frame into an InputState (or a benchmark/replay supplies one), 
+/// so the simulation can run without a window.
+/// </summary>
+struct InputState
+{
+	bool m_left{ false }; //left arrow - rotate tank anti-clockwise
+	bool m_right{ false }; //right arrow - rotate tank clockwise
+	bool m_up{ false }; //up arrow - accelerate
+	bool m_down{ false }; //down arrow - decelerate
+	bool m_turretLeft{ false }; //z - rotate turret anti-clockwise
+	bool m_turretRight{ false }; //x - rotate turret clockwise
+	bool m_centreTurret{ false }; //c - centre the turret
+	bool m_fire{ false }; //space - fire a projectile
+	bool m_restart{ false }; //return - restart from the win screen
+	bool m_exit{ false }; //escape - exit from the win screen
+
+	/// <summary>
+	/// @brief Reads the current state of the keyboard.
+	/// </summary>
+	/// <returns>The input state for the keys currently held down.</returns>
+	static InputState fromKeyboard();
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// @brief A small work-stealing job system for splitting loops across cores.
+/// 
+/// parallelFor cuts a range of indices into chunks and deals them round-robin into one
+/// queue per thread. Every thread (including the calling thread, which always joins in)
+/// takes chunks from the back of its own queue and, once that is empty, steals from the
+/// front of the other queues, so uneven chunks still keep every core busy.
+/// parallelFor returns once every chunk has run. It must not be called from inside a job.
+/// Example usage:
+///		JobSystem jobs;
+///		jobs.parallelFor(count, 16, [&](int begin, int end) { ... });
+/// </summary>
+class JobSystem
+{
+public:
+	/// <summary>
+	/// @brief Constructor that starts the worker threads.
+	/// </summary>
+	/// <param name="threadCount">The total number of threads including the caller, 
+	///  0 uses one per hardware thread</param>
+	JobSystem(int threadCount = 0);
+
+	/// <summary>
+	/// @brief Destructor that stops and joins the worker threads.
+	/// </summary>
+	~JobSystem();
+
+	JobSystem(JobSystem const &) = delete;
+	JobSystem & operator=(JobSystem const &) = delete;
+
+	/// <summary>
+	/// @brief Runs a job over the range [0, count) split into chunks, and waits for it to finish.
+	/// Chunks may run in any order and on any thread, so the job must only write data
+	///  that belongs to the indices it is given.
+	/// </summary>
+	/// <param name="count">The number of indices</param>
+	/// <param name="chunkSize">The largest number of indices given to one call of the job</param>
+	/// <param name="job">Called with the first and one past the last index of each chunk</param>
+	void parallelFor(int count, int chunkSize, std::function<void(int, int)> const & job);
+
+	/// <summary>
+	/// @brief Gets the number of threads that run jobs, including the calling thread.
+	/// </summary>
+	/// <returns>The thread count.</returns>
+	int getThreadCount() const;
+
+private:
+	/// <summary>
+	/// @brief A range of indices for one call of a job.
+	/// </summary>
+	struct Chunk
+	{
+		std::function<void(int, int)> const * m_job;
+		int m_begin;
+		int m_end;
+	};
+
+	/// <summary>
+	/// @brief The chunks waiting to run on one thread.
+	/// </summary>
+	struct Queue
+	{
+		std::mutex m_mutex;
+		std::deque<Chunk> m_chunks;
+	};
+
+	/// <summary>
+	/// @brief The loop run by each worker thread until the job system is destroyed.
+	/// </summary>
+	/// <param name="index">The index of the worker's own queue</param>
+	void workerLoop(int index);
+
+	/// <summary>
+	/// @brief Runs one chunk, taken from the thread's own queue or stolen from another.
+	/// </summary>
+	/// <param name="index">The index of the calling thread's own queue</param>
+	/// <returns>False if every queue was empty.</returns>
+	bool runOne(int index);
+
+	// One queue per thread, queue 0 belongs to the thread calling parallelFor.
+	std::vector<std::unique_ptr<Queue>> m_queues;
+
+	std::vector<std::thread> m_workers;
+
+	// The number of chunks of the current parallelFor that have not finished.
+	std::atomic<int> m_remaining{ 0 };
+
+	// Wakes sleeping workers when a parallelFor starts or the job system stops.
+	std::mutex m_wakeMutex;
+	std::condition_variable m_wake;
+	unsigned m_generation{ 0 };
+	bool m_stop{ false };
+};
@@ -5,6 +5,7 @@
 #include <sstream>
 #include <fstream>
 #include <iostream>
+#include "ScreenSize.h"
 #include "yaml-cpp\yaml.h"
 
 /// <summary>
@@ -35,6 +36,15 @@ struct BackgroundData
 	std::string m_fileName;
 };
 
+/// <summary>
+/// @brief A struct to store the size of the level's world.
+/// The world runs from (0,0) to (m_size.x,m_size.y), and levels without a "world" entry are the size of the screen.
+/// </summary>
+struct WorldData
+{
+	sf::Vector2f m_size{ static_cast<float>(ScreenSize::WIDTH), static_cast<float>(ScreenSize::HEIGHT) };
+};
+
 /// <summary>
 /// @brief A struct to represent tank data in the level.
 /// 
@@ -47,15 +57,26 @@ struct TankData
 /// <summary>
 /// @brief A struct representing all the Level Data.
 /// 
-/// Obstacles may be repeated and are therefore stored in a container.
+/// Obstacles and AI tanks may be repeated and are therefore stored in containers.
 /// </summary>
 struct LevelData
 {
 	BackgroundData m_background;
+	WorldData m_world;
 	TankData m_tank;
 	std::vector<ObstacleData> m_obstacles;
 	std::vector<TargetData> m_targets;
-	TankData m_aiTank;
+	std::vector<TankData> m_aiTanks;
+
+	/// <summary>
+	/// @brief Empties the containers, keeping their storage for the next level read into them.
+	/// </summary>
+	void clear()
+	{
+		m_obstacles.clear();
+		m_targets.clear();
+		m_aiTanks.clear();
+	}
 };
 
 /// <summary>
@@ -74,10 +95,12 @@ public:
 	LevelLoader() = default;
 
 	/// <summary>
-	/// @brief Loads and parses the yaml level file.
+	/// @brief Loads the level file.
 	/// The level file is identified by a number and is assumed to have
 	/// the following format: "level" followed by number followed by .yaml extension
 	/// E.g. "level1.yaml"
+	/// If a compiled level ("level1.bin", see compile) exists and is not older than the 
+	/// yaml file, it is loaded instead, which avoids parsing the yaml.
 	/// The level information is stored in the specified LevelData object.
 	/// If the filename is not found or the file data is invalid, an exception
 	/// is thrown.
@@ -85,4 +108,27 @@ public:
 	/// <param name="nr">The level number</param>
 	/// <param name="level">A reference to the LevelData object</param>
 	static void load(int nr, LevelData& level);
+
+	/// <summary>
+	/// @brief Loads and parses a yaml level file.
+	/// If the file is not found or the file data is invalid, an exception is thrown.
+	/// </summary>
+	/// <param name="fileName">The path of the yaml file</param>
+	/// <param name="level">A reference to the LevelData object</param>
+	static void loadYaml(std::string const& fileName, LevelData& level);
+
+	/// <summary>
+	/// @brief Compiles the yaml level file into a binary level file next to it.
+	/// E.g. "level1.yaml" is compiled to "level1.bin" (see CompiledLevel).
+	/// </summary>
+	/// <param name="nr">The level number</param>
+	static void compile(int nr);
+
+	/// <summary>
+	/// @brief Gets the path of a level file.
+	/// </summary>
+	/// <param name="nr">The level number</param>
+	/// <param name="extension">The file extension, ".yaml" or ".bin"</param>
+	/// <returns>The path, e.g. ".//resources//levels//level1.yaml".</returns>
+	static std::string getFileName(int nr, std::string const& extension);
 };
\ No newline at end of file
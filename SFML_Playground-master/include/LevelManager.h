@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include "LevelLoader.h"
+
+/// <summary>
+/// @brief Keeps track of the level being played and loads the next one in the rotation in the background.
+///
+/// The rotation runs through the numbered level files in order and then starts again at level 1.
+/// While a level is played, preloadNext() reads the next level on a loader thread, so
+/// moving on to it is only a swap of the level data and never waits on the disk.
+/// swapInNext() hands the finished level over and takes the old one back, and the next
+/// preload reads into the old level's containers, so their storage is reused.
+/// Example usage:
+///		LevelManager levels(1);
+///		levels.load(level);
+///		levels.preloadNext();
+///		...
+///		if (levels.swapInNext(level)) { rebuild the level's sprites }
+/// </summary>
+class LevelManager
+{
+public:
+	/// <summary>
+	/// @brief Constructor that stores the level to start with. Nothing is read until load().
+	/// </summary>
+	/// <param name="firstLevel">The number of the first level played</param>
+	LevelManager(int firstLevel);
+
+	/// <summary>
+	/// @brief Destructor that waits for a level still being loaded.
+	/// </summary>
+	~LevelManager();
+
+	LevelManager(LevelManager const &) = delete;
+	LevelManager & operator=(LevelManager const &) = delete;
+
+	/// <summary>
+	/// @brief Loads the current level straight away, on the calling thread.
+	/// If the level file is not found or is invalid, an exception is thrown.
+	/// </summary>
+	/// <param name="level">Receives the level data</param>
+	void load(LevelData & level);
+
+	/// <summary>
+	/// @brief Starts loading the level after the current one on the loader thread.
+	/// Does nothing while a level is still being loaded.
+	/// </summary>
+	void preloadNext();
+
+	/// <summary>
+	/// @brief Checks whether the next level has finished loading and can be swapped in.
+	/// </summary>
+	/// <returns>True when swapInNext() will succeed.</returns>
+	bool isNextReady() const;
+
+	/// <summary>
+	/// @brief Waits for the level being loaded, if any, to finish loading.
+	/// </summary>
+	void waitForNext();
+
+	/// <summary>
+	/// @brief Gets the next level's data. Only valid while isNextReady() is true.
+	/// </summary>
+	/// <returns>The next level.</returns>
+	LevelData const & getNext() const;
+
+	/// <summary>
+	/// @brief Makes the preloaded level the current one, swapping its data into the given level.
+	/// A level that failed to load is reported, and the current level carries on.
+	/// </summary>
+	/// <param name="level">The current level's data, replaced by the next level's</param>
+	/// <returns>True if the level changed, false if the next level is not ready or failed to load.</returns>
+	bool swapInNext(LevelData & level);
+
+	/// <summary>
+	/// @brief Gets the number of the level being played.
+	/// </summary>
+	/// <returns>The level number.</returns>
+	int getCurrent() const;
+
+private:
+	/// <summary>
+	/// @brief Gets the level that follows another in the rotation.
+	/// </summary>
+	/// <param name="nr">A level number</param>
+	/// <returns>The next level number with a level file, or 1 after the last.</returns>
+	static int getNextNumber(int nr);
+
+	int m_current;
+
+	// Written by the loader thread, and only read once m_ready is set.
+	int m_nextNumber{ 0 };
+	LevelData m_next;
+	std::string m_error;
+
+	std::atomic<bool> m_ready{ false };
+	std::thread m_loader;
+};
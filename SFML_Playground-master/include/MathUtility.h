@@ -23,7 +23,7 @@ namespace MathUtility
 	/// <param name="ahead">The ahead vector of the tank</param>
 	/// <param name="halfAhead">Assumed to be half the length of the ahead vector</param>
 	/// <returns>true if either vector is inside the radius of the specified circle.</returns>
-	bool lineIntersectsCircle(sf::Vector2f ahead, sf::Vector2f halfAhead, sf::CircleShape circle);
+	bool lineIntersectsCircle(sf::Vector2f ahead, sf::Vector2f halfAhead, sf::CircleShape const & circle);
 
 	/// <summary>
 	/// @brief Truncates the supplied vector so that its length is not greater than the specified number. 
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "ScreenSize.h"
+#include "WallGrid.h"
+
+/// <summary>
+/// @brief A grid of square cells over the world (see WallGrid::getWorldSize), each marked open or blocked by walls.
+/// 
+/// Baked once per level from the wall grid. A cell is blocked if any wall overlaps the
+/// cell grown by a clearance on every side, so a tank following open cells keeps its
+/// distance from the walls. Used by FlowField to route the AI tanks around the walls.
+/// </summary>
+class NavigationGrid
+{
+public:
+	/// <summary>
+	/// @brief Constructor that stores a reference to the walls.
+	/// The grid is empty until build() is called.
+	/// </summary>
+	/// <param name="walls">A reference to the grid of wall sprites</param>
+	NavigationGrid(WallGrid const & walls);
+
+	/// <summary>
+	/// @brief Marks every cell as open or blocked.
+	/// Must be called again whenever the walls or the world size change.
+	/// </summary>
+	/// <param name="cellSize">The width and height of a cell in pixels</param>
+	/// <param name="clearance">The distance in pixels a cell must be from every wall to be open</param>
+	void build(float cellSize = s_DEFAULT_CELL_SIZE, float clearance = s_DEFAULT_CLEARANCE);
+
+	/// <summary>
+	/// @brief Gets the index of the cell containing a position, clamped to the grid.
+	/// </summary>
+	/// <param name="position">A position in world coordinates</param>
+	/// <returns>The cell index.</returns>
+	int getCell(sf::Vector2f position) const;
+
+	/// <summary>
+	/// @brief Gets the centre of a cell.
+	/// </summary>
+	/// <param name="cell">The cell index</param>
+	/// <returns>The centre in world coordinates.</returns>
+	sf::Vector2f getCellCentre(int cell) const;
+
+	bool isBlocked(int column, int row) const;
+	int getColumns() const;
+	int getRows() const;
+	int getCellCount() const;
+
+private:
+	static constexpr float s_DEFAULT_CELL_SIZE{ 24.0f };
+	static constexpr float s_DEFAULT_CLEARANCE{ 16.0f };
+
+	// A reference to the grid of wall sprites.
+	WallGrid const & m_walls;
+
+	// The width and height of a cell.
+	float m_cellSize{ s_DEFAULT_CELL_SIZE };
+
+	// The grid dimensions in cells.
+	int m_columns{ 0 };
+	int m_rows{ 0 };
+
+	// 1 for each blocked cell, row by row.
+	std::vector<unsigned char> m_blocked;
+};
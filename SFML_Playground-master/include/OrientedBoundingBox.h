@@ -12,14 +12,31 @@
 /// Hosted on github at the following URL: 
 ///
 ///https://github.com/SFML/SFML/wiki/Source:-Simple-Collision-Detection-for-SFML-2
+///
+/// The corners, the two edge axes and the axis aligned bounds are calculated once on construction,
+/// so a box can be stored and reused for as long as its object does not move.
 /// </summary>
 
 class OrientedBoundingBox // Used in the BoundingBoxTest
 {
 public:
+	OrientedBoundingBox() = default; // An empty box at the origin, to be assigned later
+
 	OrientedBoundingBox(const sf::Sprite& Object); // Calculate the four points of the OBB from a transformed (scaled, rotated...) RectangleShape
 
+	OrientedBoundingBox(const sf::Transform& Trans, const sf::Vector2f& Size); // Calculate the four points of the OBB from a transform and a local size
+
 	sf::Vector2f Points[4];
 
-	void ProjectOntoAxis(const sf::Vector2f& Axis, float& Min, float& Max); // Project all four points of the OBB onto the given axis and return the dotproducts of the two outermost points
+	sf::Vector2f Axes[2]; // The two edge directions (Points[1] - Points[0] and Points[1] - Points[2]), the separating axes for this box
+
+	sf::FloatRect Bounds; // The axis aligned rectangle enclosing the four points
+
+	float AxisMin[2]{}; // The box projected onto each of its own Axes, as ProjectOntoAxis would return
+	float AxisMax[2]{};
+
+	void ProjectOntoAxis(const sf::Vector2f& Axis, float& Min, float& Max) const; // Project all four points of the OBB onto the given axis and return the dotproducts of the two outermost points
+
+private:
+	void CalculateAxesAndBounds(); // Fill in Axes, Bounds and the axis projections from the four points
 };
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+/// <summary>
+/// @brief How the particles of one kind look.
+/// </summary>
+struct ParticleStyle
+{
+	// The area of the texture drawn for each particle.
+	sf::IntRect m_textureRect;
+
+	// The colour when emitted, fading to transparent over the particle's lifetime.
+	sf::Color m_color;
+
+	// The width and height in pixels when emitted and when the particle dies.
+	float m_startSize;
+	float m_endSize;
+};
+
+/// <summary>
+/// @brief A fixed size pool of particles stored as a structure of arrays.
+///
+/// Like the ProjectilePool, the live particles are packed into the first getActiveCount()
+/// slots of parallel arrays that are allocated once, so emitting never allocates and
+/// nothing is emitted once the pool is full. Every particle of every style shares one
+/// texture, and update() writes all of them into one vertex array that is drawn with a
+/// single draw call. Particles are axis aligned quads that move, slow down, grow or shrink
+/// and fade out, so no sine or cosine is needed per particle.
+/// Example usage:
+///		ParticlePool particles(4096);
+///		particles.setTexture(texture);
+///		int sparks = particles.addStyle(ParticleStyle{ rect, sf::Color::Yellow, 6.0f, 2.0f });
+///		particles.emit(sparks, position, velocity, 0.3f);
+///		particles.update(1.0f / 60.0f);
+///		window.draw(particles);
+/// </summary>
+class ParticlePool : public sf::Drawable
+{
+public:
+	/// <summary>
+	/// @brief Constructor that allocates room for a fixed number of particles.
+	/// </summary>
+	/// <param name="capacity">The maximum number of live particles</param>
+	ParticlePool(int capacity);
+
+	/// <summary>
+	/// @brief Sets the texture shared by every particle style.
+	/// </summary>
+	/// <param name="texture">A reference to the texture</param>
+	void setTexture(sf::Texture const & texture);
+
+	/// <summary>
+	/// @brief Adds a particle style.
+	/// </summary>
+	/// <param name="style">How the particles look</param>
+	/// <returns>The style index to emit particles with.</returns>
+	int addStyle(ParticleStyle const & style);
+
+	/// <summary>
+	/// @brief Emits one particle, unless the pool is full.
+	/// </summary>
+	/// <param name="style">The style index</param>
+	/// <param name="position">The starting position</param>
+	/// <param name="velocity">The starting velocity in pixels per second</param>
+	/// <param name="lifetime">How long the particle lives in seconds</param>
+	/// <returns>False if the pool was full and nothing was emitted.</returns>
+	bool emit(int style, sf::Vector2f const & position, sf::Vector2f const & velocity, float lifetime);
+
+	/// <summary>
+	/// @brief Moves and ages every particle, removes the dead ones and rebuilds the vertex array.
+	/// </summary>
+	/// <param name="seconds">The time since the last update</param>
+	void update(float seconds);
+
+	/// <summary>
+	/// @brief Removes every particle.
+	/// </summary>
+	void clear();
+
+	/// <summary>
+	/// @brief Gets the number of live particles.
+	/// </summary>
+	/// <returns>The live particle count.</returns>
+	int getActiveCount() const;
+
+	/// <summary>
+	/// @brief Gets the maximum number of live particles.
+	/// </summary>
+	/// <returns>The pool capacity.</returns>
+	int getCapacity() const;
+
+private:
+	/// <summary>
+	/// @brief Writes a quad for every live particle into the vertex array.
+	/// </summary>
+	void buildVertices();
+
+	/// <summary>
+	/// @brief Draws every particle with one draw call.
+	/// </summary>
+	virtual void draw(sf::RenderTarget & target, sf::RenderStates states) const override;
+
+	// How quickly particles slow down, the fraction of their speed lost per second.
+	static constexpr float s_DRAG{ 2.0f };
+
+	// The maximum number of particles.
+	int m_capacity;
+
+	// The number of live particles, stored in slots [0, m_activeCount).
+	int m_activeCount{ 0 };
+
+	std::vector<float> m_positionX;
+	std::vector<float> m_positionY;
+	std::vector<float> m_velocityX;
+	std::vector<float> m_velocityY;
+
+	// Seconds since the particle was emitted, and how long it lives.
+	std::vector<float> m_age;
+	std::vector<float> m_lifetime;
+
+	std::vector<unsigned char> m_style;
+
+	std::vector<ParticleStyle> m_styles;
+
+	// Four vertices per particle, allocated once for the whole capacity.
+	std::vector<sf::Vertex> m_vertices;
+
+	// The texture shared by every particle.
+	sf::Texture const * m_texture{ nullptr };
+};
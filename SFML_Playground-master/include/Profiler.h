@@ -0,0 +1,225 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/// <summary>
+/// @brief The parts of a frame that are timed.
+/// </summary>
+enum class ProfileSection
+{
+	FRAME,
+	UPDATE,
+	AI_UPDATE,
+	PLAYER_UPDATE,
+	PROJECTILES,
+	COLLISION,
+	RENDER,
+	RENDER_STATIC_LAYER,
+	RENDER_SPRITES,
+	RENDER_TARGETS,
+	RENDER_EFFECTS,
+	RENDER_TEXT,
+	COUNT
+};
+
+/// <summary>
+/// @brief The hot path events that are counted.
+/// </summary>
+enum class ProfileCounter
+{
+	COLLISION_TESTS,
+	DRAW_CALLS,
+	STATIC_TILES_PAINTED,
+	COUNT
+};
+
+/// <summary>
+/// @brief One timed section, as copied out of the profiler's ring buffer.
+/// </summary>
+struct ProfileEvent
+{
+	// Start time and duration in nanoseconds, measured from when the profiler started.
+	std::int64_t m_start;
+	std::int64_t m_duration;
+	std::uint32_t m_frame;
+	std::uint16_t m_thread;
+	ProfileSection m_section;
+};
+
+/// <summary>
+/// @brief A slot of the profiler's ring buffer, written by one thread while others may read it.
+///
+/// Every field is atomic, so reading a slot while it is written is not a data race. The
+/// sequence is odd while the slot is written, and 2 * (index + 1) once event number index
+/// is complete, so a reader can tell a whole event from one that changed while it was copied.
+/// </summary>
+struct ProfileSlot
+{
+	std::atomic<std::uint64_t> m_sequence{ 0 };
+	std::atomic<std::int64_t> m_start{ 0 };
+	std::atomic<std::int64_t> m_duration{ 0 };
+	// The frame, thread and section packed together, see Profiler::record.
+	std::atomic<std::uint64_t> m_info{ 0 };
+};
+
+/// <summary>
+/// @brief Records timed sections and counters for the profiling overlay and trace files.
+/// 
+/// Every timed section is written to a fixed size ring buffer that keeps the most recent
+/// s_CAPACITY events. Writers claim a slot with a single atomic increment, so sections can
+/// be recorded from any thread without locks. Section times and counters are also summed 
+/// per frame, and endFrame() turns the sums into the figures shown by the overlay.
+/// While the profiler is disabled (the default), timers and counters only test one flag.
+/// The ring buffer can be written to a file while other threads are still recording. Each
+/// slot carries a sequence stamp, and events that were being written, or were overwritten,
+/// while they were copied are left out of the file rather than written half old, half new.
+/// Example usage:
+///		{
+///			ScopedTimer timer(ProfileSection::AI_UPDATE);
+///			...
+///		}
+///		Profiler::count(ProfileCounter::DRAW_CALLS);
+/// </summary>
+class Profiler
+{
+public:
+	static void setEnabled(bool enabled);
+	static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+	/// <summary>
+	/// @brief Gets the current time.
+	/// </summary>
+	/// <returns>The time in nanoseconds since the profiler started.</returns>
+	static std::int64_t now();
+
+	/// <summary>
+	/// @brief Records a timed section.
+	/// </summary>
+	/// <param name="section">The section</param>
+	/// <param name="start">The start time from now()</param>
+	/// <param name="end">The end time from now()</param>
+	static void record(ProfileSection section, std::int64_t start, std::int64_t end);
+
+	/// <summary>
+	/// @brief Adds to a counter for the current frame, if the profiler is enabled.
+	/// </summary>
+	/// <param name="counter">The counter</param>
+	/// <param name="amount">The amount to add</param>
+	static void count(ProfileCounter counter, int amount = 1)
+	{
+		if (isEnabled())
+		{
+			s_counters[static_cast<int>(counter)].fetch_add(amount, std::memory_order_relaxed);
+		}
+	}
+
+	/// <summary>
+	/// @brief Ends the current frame, storing its section times and counts and resetting them.
+	/// </summary>
+	static void endFrame();
+
+	/// <summary>
+	/// @brief Gets the time spent in a section during the last frame.
+	/// Sections that run on several threads at once report the total over all threads.
+	/// </summary>
+	/// <param name="section">The section</param>
+	/// <returns>The time in milliseconds.</returns>
+	static double getFrameMs(ProfileSection section);
+
+	/// <summary>
+	/// @brief Gets the time spent in a section, averaged over recent frames.
+	/// </summary>
+	/// <param name="section">The section</param>
+	/// <returns>The time in milliseconds.</returns>
+	static double getAverageMs(ProfileSection section);
+
+	/// <summary>
+	/// @brief Gets the total of a counter during the last frame.
+	/// </summary>
+	/// <param name="counter">The counter</param>
+	/// <returns>The count.</returns>
+	static int getFrameCount(ProfileCounter counter);
+
+	static char const * getName(ProfileSection section);
+	static char const * getName(ProfileCounter counter);
+
+	/// <summary>
+	/// @brief Writes the events in the ring buffer as comma separated values, oldest first.
+	/// </summary>
+	/// <param name="fileName">The path of the file</param>
+	/// <returns>False if the file could not be written.</returns>
+	static bool writeCsv(std::string const & fileName);
+
+	/// <summary>
+	/// @brief Writes the events in the ring buffer in the Chrome trace event format, which can 
+	///  be opened with chrome://tracing or Perfetto.
+	/// </summary>
+	/// <param name="fileName">The path of the file</param>
+	/// <returns>False if the file could not be written.</returns>
+	static bool writeChromeTrace(std::string const & fileName);
+
+	// The number of events kept in the ring buffer, a power of two.
+	static constexpr std::uint64_t s_CAPACITY{ 1 << 16 };
+
+private:
+	/// <summary>
+	/// @brief Gets a small number identifying the calling thread.
+	/// </summary>
+	static std::uint16_t getThreadIndex();
+
+	/// <summary>
+	/// @brief Calls a function with a copy of each whole event in the ring buffer, oldest first.
+	/// Events being written while they are copied are skipped.
+	/// </summary>
+	template <typename Function>
+	static void forEachEvent(Function function);
+
+	static std::atomic<bool> s_enabled;
+
+	// The ring buffer and the total number of events ever written to it.
+	static ProfileSlot s_events[s_CAPACITY];
+	static std::atomic<std::uint64_t> s_written;
+
+	// Section times and counts for the frame in progress.
+	static std::atomic<std::int64_t> s_sectionTimes[static_cast<int>(ProfileSection::COUNT)];
+	static std::atomic<int> s_counters[static_cast<int>(ProfileCounter::COUNT)];
+
+	// Section times and counts for the last frame, and the averages.
+	static std::int64_t s_frameTimes[static_cast<int>(ProfileSection::COUNT)];
+	static double s_averageTimes[static_cast<int>(ProfileSection::COUNT)];
+	static int s_frameCounts[static_cast<int>(ProfileCounter::COUNT)];
+
+	static std::atomic<std::uint32_t> s_frame;
+};
+
+/// <summary>
+/// @brief Times the section from its construction to the end of its scope.
+/// </summary>
+class ScopedTimer
+{
+public:
+	ScopedTimer(ProfileSection section)
+		: m_section(section)
+		, m_start(Profiler::isEnabled() ? Profiler::now() : -1)
+	{
+	}
+
+	~ScopedTimer()
+	{
+		if (m_start >= 0)
+		{
+			Profiler::record(m_section, m_start, Profiler::now());
+		}
+	}
+
+	ScopedTimer(ScopedTimer const &) = delete;
+	ScopedTimer & operator=(ScopedTimer const &) = delete;
+
+private:
+	ProfileSection m_section;
+
+	// The start time, or -1 if the profiler was disabled when the timer started.
+	std::int64_t m_start;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "Profiler.h"
+
+/// <summary>
+/// @brief An on-screen table of the profiler's section times and counters.
+/// 
+/// Drawn below the HUD while the profiler is enabled. The text is only rebuilt every few
+/// frames, so the figures stay readable and the overlay adds little to the frame it measures.
+/// </summary>
+class ProfilerOverlay
+{
+public:
+	/// <summary>
+	/// @brief Constructor that stores a font for the overlay and sets up its appearance.
+	/// </summary>
+	/// <param name="font">A reference to the font</param>
+	ProfilerOverlay(sf::Font const & font);
+
+	/// <summary>
+	/// @brief Refreshes the text from the profiler, every s_REFRESH_FRAMES calls.
+	/// </summary>
+	void update();
+
+	/// <summary>
+	/// @brief Draws the overlay if the profiler is enabled.
+	/// </summary>
+	/// <param name="window">The SFML Render window</param>
+	void render(sf::RenderWindow & window);
+
+private:
+	// The number of frames between text refreshes.
+	static int const s_REFRESH_FRAMES{ 15 };
+
+	int m_framesUntilRefresh{ 0 };
+
+	// The section and counter names, and their figures in a second column.
+	sf::Text m_names;
+	sf::Text m_values;
+
+	sf::RectangleShape m_background;
+};
@@ -1,56 +1,184 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-#include <array>
-#include "Projectile.h"
+#include <vector>
+#include "ScreenSize.h"
+#include "MathUtility.h"
+#include "CollisionDetector.h"
+#include "WallGrid.h"
+#include "SpriteBatch.h"
+#include "Collider.h"
+#include "CollisionEvent.h"
+#include "StateHash.h"
 
+/// <summary>
+/// @brief A pool of projectiles stored as a structure of arrays.
+/// 
+/// Each projectile is a position and a unit direction vector (calculated once when it is
+/// fired) held in parallel arrays. The live projectiles are always packed into the first
+/// getActiveCount() slots, so movement and the on-screen test are simple loops over 
+/// contiguous floats that the compiler can vectorise. Projectiles only become textured
+/// quads when the pool is added to a sprite batch for drawing.
+/// </summary>
 class ProjectilePool
 {
 public:
 
 	/// <summary>
-	/// @brief No-op default constructor
+	/// @brief Constructor that allocates room for a fixed number of projectiles.
 	/// </summary>
-	ProjectilePool() = default;
+	/// <param name="size">The maximum number of live projectiles</param>
+	ProjectilePool(int size = s_DEFAULT_POOL_SIZE);
 
 	/// <summary>
 	/// @brief Creates a projectile.
 	/// Creates a projectile from the pool of available projectiles.
 	///  If no projectiles are available, the next in (pool) sequence after
-	///  the last used projectile is chosen.
+	///  the last reused projectile is chosen.
 	/// </summary>
-	/// <param name="texture">A reference to the sprite sheet texture</param>	
 	/// <param name="x">The x position of the projectile</param>
 	/// <param name="x">The y position of the projectile</param>
 	/// <param name="rotation">The rotation angle of the projectile in degrees</param>
-	void create(sf::Texture const & texture, double x, double y, double rotation);
+	void create(double x, double y, double rotation);
 
 	/// <summary>
 	/// @brief Updates all projectiles in the pool.
-	/// Sets an index to the next available projectile. Also sets a 
-	///  status flag to indicate pool full (all projectiles in use).
+	/// Moves every live projectile, sweeping it from its last position to its new one against
+	///  the nearby walls and the target tank, then removes those that left the screen.
+	///  Projectiles that hit something are removed from the pool, and a collision event is
+	///  added for the first thing each one hit.
 	/// </summary>
 	/// <param name="dt">The delta time</param>	
-	/// <param name="rotation">A reference to the container of wall sprites</param>
-	int update(double dt, std::vector<sf::Sprite> & wallSprites, std::pair<sf::Sprite, sf::Sprite> aiTankSprites);
+	/// <param name="walls">A reference to the grid of wall sprites</param>
+	/// <param name="target">The colliders of the target tank base and turret</param>
+	/// <param name="shooter">The id of the tank that fired the projectiles</param>
+	/// <param name="victim">The id of the target tank</param>
+	/// <param name="tick">The simulation update number</param>
+	/// <param name="events">Appended with an event for each projectile that hit a wall or the target</param>
+	void update(double dt, WallGrid const & walls, TankColliders const & target, int shooter, int victim, std::uint32_t tick, CollisionEventBuffer & events);
 
 	/// <summary>
-	/// @brief Draws all active projectiles.
+	/// @brief Updates all projectiles in the pool against several target tanks.
+	/// A projectile is removed by the first wall or target it hits.
 	/// </summary>
-	/// <param name="window">The SFML render window</param>	
-	void render(sf::RenderWindow & window);
+	/// <param name="dt">The delta time</param>	
+	/// <param name="walls">A reference to the grid of wall sprites</param>
+	/// <param name="targets">The colliders of the target tanks, whose indices are the victim ids</param>
+	/// <param name="shooter">The id of the tank that fired the projectiles</param>
+	/// <param name="tick">The simulation update number</param>
+	/// <param name="events">Appended with an event for each projectile that hit a wall or a target</param>
+	void update(double dt, WallGrid const & walls, std::vector<TankColliders> const & targets, int shooter, std::uint32_t tick, CollisionEventBuffer & events);
+
+	/// <summary>
+	/// @brief Adds the active projectiles in an area, as of the previous and the latest update, to the sprites to draw.
+	/// </summary>
+	/// <param name="sprites">The sprites to draw with the sprite sheet texture</param>	
+	/// <param name="area">The part of the world being drawn, projectiles outside it are skipped</param>
+	void render(std::vector<SpriteInstance> & sprites, sf::FloatRect const & area) const;
+
+	/// <summary>
+	/// @brief Gets the number of projectiles currently in flight.
+	/// </summary>
+	/// <returns>The live projectile count.</returns>
+	int getActiveCount() const;
+
+	/// <summary>
+	/// @brief Gets the maximum number of projectiles this pool can hold.
+	/// </summary>
+	/// <returns>The pool size.</returns>
+	int getSize() const;
 
+	/// <summary>
+	/// @brief Adds the live projectiles to a hash of the simulation state.
+	/// </summary>
+	/// <param name="hash">The hash to add to</param>
+	void hashState(StateHash & hash) const;
 
 private:
-	static const int s_POOL_SIZE = 100;
+	/// <summary>
+	/// @brief Moves, culls and collides every projectile, shared by both update overloads.
+	/// </summary>
+	/// <param name="dt">The delta time</param>	
+	/// <param name="walls">A reference to the grid of wall sprites</param>
+	/// <param name="targets">The first of targetCount target colliders</param>
+	/// <param name="targetCount">The number of targets</param>
+	/// <param name="shooter">The id of the tank that fired the projectiles</param>
+	/// <param name="tick">The simulation update number</param>
+	/// <param name="events">Appended with an event for each hit, with the target index as the victim</param>
+	void updateTargets(double dt, WallGrid const & walls, TankColliders const * targets, int targetCount, int shooter, std::uint32_t tick, CollisionEventBuffer & events);
+
+	/// <summary>
+	/// @brief Moves every live projectile along its direction vector.
+	/// </summary>
+	/// <param name="distance">The distance travelled this update</param>
+	void integrate(float distance);
+
+	/// <summary>
+	/// @brief Clears the alive flag of every projectile that has left the world.
+	/// </summary>
+	/// <param name="worldSize">The width and height of the world</param>
+	void cull(sf::Vector2f worldSize);
+
+	/// <summary>
+	/// @brief Removes the projectiles whose alive flag is cleared, keeping the rest packed 
+	///  at the front of the arrays in their original order.
+	/// </summary>
+	void compact();
+
+	/// <summary>
+	/// @brief Builds the transform a sprite of a live projectile would have at a position, 
+	///  from its direction instead of calling cos and sin.
+	/// </summary>
+	/// <param name="index">The projectile index</param>
+	/// <param name="position">The position of the projectile's centre</param>
+	/// <returns>The transform from local projectile coordinates to the world.</returns>
+	sf::Transform getTransform(int index, sf::Vector2f const & position) const;
+
+	/// <summary>
+	/// @brief Builds the bounding box of a live projectile at a position.
+	/// </summary>
+	/// <param name="index">The projectile index</param>
+	/// <param name="position">The position of the projectile's centre</param>
+	/// <returns>The oriented bounding box of the projectile.</returns>
+	OrientedBoundingBox getBox(int index, sf::Vector2f const & position) const;
+
+	static const int s_DEFAULT_POOL_SIZE = 100;
+
+	// Movement speed in pixels per second.
+	static constexpr float s_MAX_SPEED{ 1000.0f };
+
+	// The maximum number of projectiles.
+	int m_size;
+
+	// The number of live projectiles, stored in slots [0, m_activeCount).
+	int m_activeCount{ 0 };
+
+	// The slot to reuse next if the pool is full.
+	int m_nextReused{ 0 };
+
+	// Projectile positions.
+	std::vector<float> m_positionX;
+	std::vector<float> m_positionY;
+
+	// Projectile positions before the latest update, only used for drawing.
+	std::vector<float> m_previousX;
+	std::vector<float> m_previousY;
+
+	// Unit vectors along the direction of travel.
+	std::vector<float> m_directionX;
+	std::vector<float> m_directionY;
+
+	// The rotation angle in degrees, only used for drawing.
+	std::vector<float> m_rotation;
 
-	// A container for the projectiles.
-	std::array<Projectile, s_POOL_SIZE> m_projectiles;
+	// 1 while a projectile is live, cleared when it leaves the screen or hits something.
+	std::vector<unsigned char> m_alive;
 
-	// The index of the next available projectile.
-	int m_nextAvailable { 0 };
+	// The bounding rectangle for a projectile.
+	sf::IntRect m_projectileRect{ 5, 178, 10, 6 };
 
-	// A flag indicating whether there are any projectiles available (initially they are).
-	bool m_poolFull { false };
+	// Scratch storage for the walls near a projectile, reused by every projectile.
+	std::vector<int> m_nearbyWalls;
 
-	std::pair<bool, bool> m_result;
-};
\ No newline at end of file
+	// Scratch storage for the target bounding boxes (base then turret for each target), reused every update.
+	std::vector<OrientedBoundingBox> m_targetBoxes;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "GameState.h"
+#include "HUD.h"
+#include "SpriteBatch.h"
+
+/// <summary>
+/// @brief Everything Game::render needs from one simulation update.
+///
+/// The simulation fills a snapshot after it updates, and rendering only reads the snapshot,
+/// never the simulation itself. That lets the two run on different threads, with the
+/// snapshots passed between them through a TripleBuffer. Snapshots are reused, so their
+/// containers keep their storage from one update to the next.
+/// </summary>
+struct RenderSnapshot
+{
+	GameState m_gameState{ GameState::GAME_RUNNING };
+
+	HudValues m_hud{ 0, 0, 0, 0, 0, GameState::GAME_RUNNING };
+
+	// The centre of the camera as of this update and the one before, blended like the sprites.
+	sf::Vector2f m_cameraCentre;
+	sf::Vector2f m_lastCameraCentre;
+
+	// The tanks and projectiles near the camera, in drawing order, as of this update and the one before.
+	std::vector<SpriteInstance> m_sprites;
+
+	// The live targets near the camera. Targets never move, so their previous and current places are the same.
+	std::vector<SpriteInstance> m_targets;
+
+	// The AI vision cones, as triangle fans stored one after another, and the vertex count of each.
+	std::vector<sf::Vertex> m_vision;
+	std::vector<int> m_visionSizes;
+
+	// The scoreboard text, only filled in on the win screen, and the score table version it shows.
+	std::string m_scores;
+	int m_scoreVersion{ -1 };
+
+	// The current level's wall sprites and world size, and a version that changes whenever the
+	// walls are generated again. The walls are never changed once published, only replaced, so
+	// every snapshot of a level shares them and render can rebuild its wall batches from them.
+	std::shared_ptr<std::vector<sf::Sprite> const> m_walls;
+	sf::Vector2f m_worldSize;
+	int m_wallVersion{ 0 };
+
+	// The current level's background image, and the next level's once it has been preloaded.
+	std::string m_background;
+	std::string m_nextBackground;
+
+	// When the snapshot was published, in microseconds of std::chrono::steady_clock.
+	std::int64_t m_publishTime{ 0 };
+};
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <Thor/Resources.hpp>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// @brief Loads every texture and font once, keyed by file name, and shares it with whoever asks.
+///
+/// Textures and fonts are held in thor::ResourceHolders, so asking for the same file again
+/// (on a restart or in another level) returns the resource that is already loaded.
+/// Small images can also be packed into one atlas texture, so sprites cut from any of them
+/// can share a sprite batch and the renderer does not switch textures between them.
+/// Large images can be loaded in the background: the files are decoded on a loader thread,
+/// and update() turns them into textures and calls the ready callback on the main thread.
+/// A file that fails to load is reported once and replaced by an empty resource, so callers
+/// always get something to hold on to. A cache created without file loading (for headless
+/// games) hands out empty resources, but still lays out the atlas so its texture rectangles
+/// are the same as a windowed game's.
+/// Example usage:
+///		ResourceCache resources;
+///		resources.buildAtlas({ "SpriteSheet.png", "E-100.png" });
+///		sprite.setTexture(resources.getAtlas());
+///		sprite.setTextureRect(resources.getAtlasRect("E-100.png"));
+///		resources.loadAsync({ "Background.jpg" }, [&]() { background.setTexture(resources.getTexture("Background.jpg")); });
+/// </summary>
+class ResourceCache
+{
+public:
+	/// <summary>
+	/// @brief Constructor for an empty cache.
+	/// </summary>
+	/// <param name="loadFiles">False to hand out empty resources instead of loading files</param>
+	ResourceCache(bool loadFiles = true);
+
+	/// <summary>
+	/// @brief Destructor that stops the loader thread, dropping any loads not yet finished.
+	/// </summary>
+	~ResourceCache();
+
+	ResourceCache(ResourceCache const &) = delete;
+	ResourceCache & operator=(ResourceCache const &) = delete;
+
+	/// <summary>
+	/// @brief Gets a texture, loading it the first time it is asked for.
+	/// </summary>
+	/// <param name="fileName">The path of the image file</param>
+	/// <returns>The texture, which lives as long as the cache.</returns>
+	sf::Texture & getTexture(std::string const & fileName);
+
+	/// <summary>
+	/// @brief Gets a font, loading it the first time it is asked for.
+	/// </summary>
+	/// <param name="fileName">The path of the font file</param>
+	/// <returns>The font, which lives as long as the cache.</returns>
+	sf::Font & getFont(std::string const & fileName);
+
+	/// <summary>
+	/// @brief Packs images into the atlas texture, replacing what it held.
+	/// Images are placed in rows in the order given, so the first image sits at the top left
+	///  and any texture rectangles measured on that image still apply to the atlas.
+	/// Without file loading the images are only read to lay out the texture rectangles,
+	///  and the atlas texture stays empty.
+	/// </summary>
+	/// <param name="fileNames">The paths of the image files</param>
+	void buildAtlas(std::vector<std::string> const & fileNames);
+
+	/// <summary>
+	/// @brief Gets the atlas texture. The reference is valid before the atlas is built.
+	/// </summary>
+	/// <returns>The atlas texture.</returns>
+	sf::Texture const & getAtlas() const;
+
+	/// <summary>
+	/// @brief Gets where an image was placed in the atlas.
+	/// </summary>
+	/// <param name="fileName">The path the image was packed from</param>
+	/// <returns>The image's area of the atlas, empty if the image is not in the atlas.</returns>
+	sf::IntRect getAtlasRect(std::string const & fileName) const;
+
+	/// <summary>
+	/// @brief Starts loading textures on the loader thread. Files that are already loaded are not read again.
+	/// </summary>
+	/// <param name="fileNames">The paths of the image files</param>
+	/// <param name="onReady">Called by update() on the main thread once every texture can be used</param>
+	void loadAsync(std::vector<std::string> const & fileNames, std::function<void()> onReady);
+
+	/// <summary>
+	/// @brief Turns images decoded in the background into textures and calls their ready callbacks.
+	/// Must be called regularly from the thread that owns the window, once per frame is enough.
+	/// </summary>
+	void update();
+
+	/// <summary>
+	/// @brief Checks whether any background load has not had its ready callback called yet.
+	/// </summary>
+	/// <returns>True while loading.</returns>
+	bool isLoading() const;
+
+private:
+	/// <summary>
+	/// @brief One call of loadAsync, passed to the loader thread and back.
+	/// </summary>
+	struct Request
+	{
+		std::vector<std::string> m_fileNames;
+		std::vector<sf::Image> m_images;
+		std::vector<bool> m_loaded;
+		std::function<void()> m_onReady;
+	};
+
+	/// <summary>
+	/// @brief Gets a resource from a holder, loading it the first time, or holding an empty one if it fails.
+	/// </summary>
+	template <typename R>
+	R & acquire(thor::ResourceHolder<R, std::string> & holder, std::string const & fileName, thor::ResourceLoader<R> const & loader);
+
+	/// <summary>
+	/// @brief Checks whether a texture is already held, loaded or empty.
+	/// </summary>
+	bool hasTexture(std::string const & fileName);
+
+	/// <summary>
+	/// @brief The loop run by the loader thread, which decodes queued images until stopped.
+	/// </summary>
+	void loadLoop();
+
+	// The width the atlas rows are packed into, widened for any image wider than this.
+	static unsigned const s_ATLAS_WIDTH{ 512 };
+
+	// Empty pixels left between packed images, so smoothing never blends in a neighbour.
+	static unsigned const s_ATLAS_PADDING{ 1 };
+
+	bool m_loadFiles;
+
+	thor::ResourceHolder<sf::Texture, std::string> m_textures;
+	thor::ResourceHolder<sf::Font, std::string> m_fonts;
+
+	sf::Texture m_atlas;
+	std::map<std::string, sf::IntRect> m_atlasRects;
+
+	// Requests waiting for and finished by the loader thread, guarded by m_mutex.
+	mutable std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::deque<std::unique_ptr<Request>> m_queued;
+	std::vector<std::unique_ptr<Request>> m_finished;
+	int m_loadingCount{ 0 };
+	bool m_stop{ false };
+
+	// Started by the first loadAsync().
+	std::thread m_loader;
+};
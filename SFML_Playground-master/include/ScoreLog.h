@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/// The records below are stored in the files exactly as laid out here (little endian,
+///  4 byte fields).
+
+/// <summary>
+/// @brief One finished game, as shown on the scoreboard and stored in the score log.
+/// </summary>
+struct ScoreEntry
+{
+	std::int32_t m_score;
+	float m_accuracy;
+};
+
+/// <summary>
+/// @brief The first bytes of a score log, followed by one ScoreEntry per finished game.
+/// </summary>
+struct ScoreLogHeader
+{
+	char m_magic[4];
+	std::uint32_t m_version;
+};
+
+/// <summary>
+/// @brief The first bytes of a score index, followed by m_count ScoreEntry records, highest first.
+/// </summary>
+struct ScoreIndexHeader
+{
+	char m_magic[4];
+	std::uint32_t m_version;
+	// The number of log records the index was built from.
+	std::uint32_t m_recordCount;
+	// The most entries the index was built to hold.
+	std::uint32_t m_capacity;
+	std::uint32_t m_count;
+};
+
+/// <summary>
+/// @brief An append-only binary log of every finished game, with an index of the best ones.
+///
+/// Games are appended to the log as fixed size records and never rewritten. The best
+/// scores are also kept in a small index file (the log's name plus ".idx"), so opening the
+/// log reads the index and only the records appended since it was written, however long
+/// the history gets. The index is replaced by writing a temporary file and renaming it over
+/// the old one, so a crash leaves either the old or the new index. A record cut short by a
+/// crash is dropped when the log is next opened, and a missing or damaged index is rebuilt
+/// from the whole log.
+/// Example usage:
+///		ScoreLog log(".//resources//data//scores.dat", 10);
+///		log.open();
+///		log.append({ { 20, 62.5f } });
+///		for (ScoreEntry const& entry : log.getTop()) { ... }
+/// </summary>
+class ScoreLog
+{
+public:
+	/// <summary>
+	/// @brief Constructor that stores the log location. Nothing is read until open().
+	/// </summary>
+	/// <param name="fileName">The path of the score log</param>
+	/// <param name="capacity">The number of best scores kept in the index</param>
+	ScoreLog(std::string const & fileName, int capacity);
+
+	/// <summary>
+	/// @brief Reads the best scores from the index and any records the index does not cover yet,
+	///  rewriting the index if it was out of date. A missing log is treated as empty.
+	/// If the log exists but is not a score log of the current version, it is renamed with ".bad"
+	///  added and its index removed, so the next append starts a new log, and an exception is thrown.
+	/// </summary>
+	void open();
+
+	/// <summary>
+	/// @brief Appends finished games to the log and updates the index, starting the log if there is none.
+	/// An exception is thrown if the log cannot be written, or if open() found a file that is not
+	///  a score log and could not move it aside.
+	/// </summary>
+	/// <param name="entries">The games to append, in the order they finished</param>
+	void append(std::vector<ScoreEntry> const & entries);
+
+	/// <summary>
+	/// @brief Gets the best scores, highest first.
+	/// </summary>
+	/// <returns>Up to capacity score entries.</returns>
+	std::vector<ScoreEntry> const & getTop() const;
+
+	/// <summary>
+	/// @brief Gets the number of games in the log.
+	/// </summary>
+	/// <returns>The record count.</returns>
+	int getRecordCount() const;
+
+	/// <summary>
+	/// @brief Converts a text score file of "Score: X  Accuracy: Y" lines to a new score log and index.
+	/// Lines that are not scores are skipped. An exception is thrown if the log cannot be written.
+	/// </summary>
+	/// <param name="textFileName">The path of the text score file</param>
+	/// <param name="fileName">The path of the score log to create, replacing any existing log</param>
+	/// <param name="capacity">The number of best scores kept in the index</param>
+	/// <returns>The number of scores converted.</returns>
+	static int convertText(std::string const & textFileName, std::string const & fileName, int capacity);
+
+	/// <summary>
+	/// @brief Orders scores highest first, with accuracy breaking ties.
+	/// </summary>
+	static bool isHigher(ScoreEntry const & a, ScoreEntry const & b);
+
+	/// <summary>
+	/// @brief Inserts an entry into a list of scores kept highest first, dropping any entry past the capacity.
+	/// Equal entries keep the order they were inserted in.
+	/// </summary>
+	static void insert(std::vector<ScoreEntry> & top, ScoreEntry const & entry, int capacity);
+
+private:
+	/// <summary>
+	/// @brief Reads the index into m_top if it matches the log.
+	/// </summary>
+	/// <returns>True if the index was read.</returns>
+	bool readIndex(int recordCount);
+
+	/// <summary>
+	/// @brief Writes m_top as the index, through a temporary file.
+	/// </summary>
+	void writeIndex() const;
+
+	/// <summary>
+	/// @brief Renames a file that is not a score log out of the way and removes its index.
+	/// If it cannot be renamed, appending is refused rather than mixing records into it.
+	/// </summary>
+	void setAside();
+
+	/// <summary>
+	/// @brief Reads log records [first, last) into m_top.
+	/// </summary>
+	void readRecords(std::istream & log, int first, int last);
+
+	static std::uint32_t const s_VERSION{ 1 };
+
+	std::string m_fileName;
+	std::string m_indexFileName;
+	int m_capacity;
+
+	std::vector<ScoreEntry> m_top;
+	int m_recordCount{ 0 };
+
+	// False after open() found a file that is not a score log and could not move it aside.
+	bool m_writable{ true };
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ScoreLog.h"
+
+/// <summary>
+/// @brief The best scores kept in memory, backed by a binary score log.
+///
+/// The best scores are read from the score log's index once by load(). After that the table
+/// is only changed by add(), which inserts the new result into the sorted in-memory table and
+/// queues it for the log. Queued results are appended by a writer thread, so the game never
+/// waits on the disk.
+/// getVersion() changes whenever the table does, so callers only rebuild their text
+/// when there is something new to show.
+/// Example usage:
+///		ScoreTable scores("scores.dat");
+///		scores.load("scores.txt");
+///		scores.add(20, 62.5f);
+///		text.setString(scores.getText());
+/// </summary>
+class ScoreTable
+{
+public:
+	/// <summary>
+	/// @brief Constructor that stores the score log location. Nothing is read until load().
+	/// </summary>
+	/// <param name="fileName">The path of the score log</param>
+	/// <param name="capacity">The number of best scores kept in memory</param>
+	ScoreTable(std::string const & fileName, int capacity = s_DEFAULT_CAPACITY);
+
+	/// <summary>
+	/// @brief Destructor that writes any queued results and stops the writer thread.
+	/// </summary>
+	~ScoreTable();
+
+	ScoreTable(ScoreTable const &) = delete;
+	ScoreTable & operator=(ScoreTable const &) = delete;
+
+	/// <summary>
+	/// @brief Reads the best scores from the score log into the table, replacing its contents.
+	/// If there is no score log yet, one is first converted from the old text score file.
+	/// A damaged score log is reported and leaves the table empty. A file that is not a score log
+	///  is moved aside by ScoreLog::open(), so the next result starts a new log.
+	/// </summary>
+	/// <param name="textFileName">The path of the old text score file</param>
+	void load(std::string const & textFileName);
+
+	/// <summary>
+	/// @brief Adds a finished game to the table and queues it to be appended to the score log.
+	/// </summary>
+	/// <param name="score">The player's score</param>
+	/// <param name="accuracy">The player's accuracy as a percentage</param>
+	void add(int score, float accuracy);
+
+	/// <summary>
+	/// @brief Blocks until every queued result has been written to the score log.
+	/// </summary>
+	void flush();
+
+	/// <summary>
+	/// @brief Gets the best scores, highest first.
+	/// </summary>
+	/// <returns>The score entries.</returns>
+	std::vector<ScoreEntry> const & getEntries() const;
+
+	/// <summary>
+	/// @brief Gets the scores as one line each, highest first.
+	/// </summary>
+	/// <returns>The scoreboard text.</returns>
+	std::string const & getText() const;
+
+	/// <summary>
+	/// @brief Gets a number that changes every time the table changes.
+	/// </summary>
+	/// <returns>The table version.</returns>
+	int getVersion() const;
+
+private:
+	/// <summary>
+	/// @brief Rebuilds the scoreboard text and moves on the version.
+	/// </summary>
+	void updateText();
+
+	/// <summary>
+	/// @brief Formats a score entry as one line of the scoreboard.
+	/// </summary>
+	static std::string toLine(ScoreEntry const & entry);
+
+	/// <summary>
+	/// @brief The loop run by the writer thread, which appends queued results until stopped.
+	/// </summary>
+	void writeLoop();
+
+	static int const s_DEFAULT_CAPACITY{ 10 };
+
+	std::string m_fileName;
+	int m_capacity;
+
+	// Only used by load() and, after that, by the writer thread.
+	ScoreLog m_log;
+
+	// The best scores, highest first, and the same as text.
+	std::vector<ScoreEntry> m_entries;
+	std::string m_text;
+	int m_version{ 0 };
+
+	// Results waiting for the writer thread, guarded by m_mutex.
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_written;
+	std::vector<ScoreEntry> m_pending;
+	bool m_writing{ false };
+	bool m_stop{ false };
+
+	// Started by the first add(), so a game that never finishes has no extra thread.
+	std::thread m_writer;
+};
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "Game.h"
+
+/// <summary>
+/// @brief Runs the game simulation headlessly at a fixed step and reports its cost.
+/// 
+/// Each run creates a headless Game with a fixed random seed, drives the player tank
+/// with a scripted input pattern and times a number of Game::step calls. Runs are repeated
+/// for increasing wall counts so the cost can be compared as the level grows.
+/// A second set of runs times a large projectile pool on its own, kept topped up to a
+/// fixed number of live projectiles among randomly placed walls.
+/// A third set of runs updates a large number of AI tanks with an increasing number of
+/// threads, to show how the parallel steering scales with cores.
+/// A level of s_LEVEL_OBSTACLES generated obstacles is loaded from yaml and from its compiled
+/// binary form to compare startup costs.
+/// A last run compares passing the target tank to the pool as sprite copies against
+/// passing it as collider views.
+/// replay() plays a recorded game again, so real sessions can be used as benchmarks too.
+/// checkScoreLog() checks how the score log recovers from files it cannot read.
+/// The particle pool is timed on its own with s_PARTICLES live particles, moving them and
+/// building their vertices as a frame would, against a budget of s_PARTICLE_BUDGET_MS.
+/// Example usage:
+///		SimulationBenchmark benchmark(20000);
+///		benchmark.run();
+/// </summary>
+class SimulationBenchmark
+{
+public:
+	/// <summary>
+	/// @brief Constructor that stores the number of ticks to simulate per run.
+	/// </summary>
+	/// <param name="ticks">The number of fixed updates per run</param>
+	SimulationBenchmark(int ticks);
+
+	/// <summary>
+	/// @brief Runs the benchmark for every wall count and projectile count and prints tables of results.
+	/// </summary>
+	void run();
+
+	/// <summary>
+	/// @brief Plays a recorded game again headlessly, as fast as it will go, and reports its cost.
+	/// The game is created with the recorded seed and level and given the recorded input of
+	///  every update, then its final state is checked against the recorded state hash, so a
+	///  change that alters gameplay in any way shows up as a mismatch.
+	/// An exception is thrown if the input log cannot be read.
+	/// </summary>
+	/// <param name="fileName">The path of an input log saved by a game run with GameSettings::m_recordFile</param>
+	/// <returns>True if the replayed game ended in exactly the recorded state.</returns>
+	static bool replay(std::string const& fileName);
+
+	/// <summary>
+	/// @brief Checks that score logs which are not score logs of the current version, one with
+	///  the wrong magic and one with the wrong version, are moved aside when opened and that
+	///  games appended afterwards go into a new log that opens again with just those games.
+	/// The files are written to the system temporary directory and removed afterwards.
+	/// </summary>
+	/// <returns>True if every check passed.</returns>
+	static bool checkScoreLog();
+
+private:
+	/// <summary>
+	/// @brief The timing results of a single run.
+	/// </summary>
+	struct Result
+	{
+		int m_walls;
+		int m_ticks;
+		double m_totalMs;
+	};
+
+	/// <summary>
+	/// @brief Simulates the configured number of ticks with the given settings.
+	/// </summary>
+	/// <param name="settings">The settings used to create the headless game</param>
+	/// <returns>The timing results for this run.</returns>
+	Result runOnce(GameSettings const& settings) const;
+
+	/// <summary>
+	/// @brief Times the update of a projectile pool holding a fixed number of live projectiles.
+	/// </summary>
+	/// <param name="projectiles">The number of live projectiles</param>
+	/// <param name="walls">A reference to the grid of walls the projectiles collide with</param>
+	/// <returns>The total time in milliseconds for s_PROJECTILE_TICKS ticks.</returns>
+	double runProjectiles(int projectiles, WallGrid const& walls) const;
+
+	/// <summary>
+	/// @brief Times the update of s_AI_TANKS AI tanks using a number of threads.
+	/// </summary>
+	/// <param name="threads">The number of threads, including the calling thread</param>
+	/// <param name="walls">A reference to the grid of walls the tanks avoid</param>
+	/// <param name="checksum">Set to the sum of the final tank coordinates, which is the same for any thread count</param>
+	/// <returns>The total time in milliseconds for s_AI_TICKS ticks.</returns>
+	double runAiTanks(int threads, WallGrid const& walls, double & checksum) const;
+
+	/// <summary>
+	/// @brief Times loading a large generated level from yaml, from a compiled level through 
+	///  its views, and from a compiled level copied into LevelData.
+	/// The level files are written to the system temporary directory and removed afterwards.
+	/// </summary>
+	void runLevelLoading() const;
+
+	/// <summary>
+	/// @brief Times building target bounding boxes from sprite copies and from collider views.
+	/// Both loops do the same collision work, so the difference is the cost of the copies.
+	/// </summary>
+	void runTargetPassing() const;
+
+	/// <summary>
+	/// @brief Times updating a particle pool kept full with s_PARTICLES live particles.
+	/// Each update moves every particle and writes its quad, which is all a frame does
+	///  before the single draw call.
+	/// </summary>
+	void runParticles() const;
+
+	/// <summary>
+	/// @brief Simulates the shipped level whose world is many screens across, then times
+	///  flow field searches over it and over the first, one screen, level.
+	/// Also counts the walls the camera shows at the player's start, against the level's total.
+	/// </summary>
+	void runLargeWorld() const;
+
+	/// <summary>
+	/// @brief The scripted player input for a tick.
+	/// The tank drives in loops, sweeps its turret and fires continuously so the 
+	///  projectile and wall collision code is exercised.
+	/// </summary>
+	/// <param name="tick">The tick number</param>
+	/// <returns>The input for that tick.</returns>
+	static InputState scriptedInput(int tick);
+
+	/// <summary>
+	/// @brief Prints the results of a single run.
+	/// </summary>
+	/// <param name="result">The results to print</param>
+	static void print(Result const& result);
+
+	// The number of fixed updates per run.
+	int m_ticks;
+
+	// The fixed seed so every run simulates the same game.
+	static unsigned const s_SEED{ 12345 };
+
+	// The extra wall counts to benchmark.
+	std::vector<int> m_wallCounts{ 0, 100, 1000, 5000 };
+
+	// The live projectile counts to benchmark.
+	std::vector<int> m_projectileCounts{ 100, 1000, 10000, 50000 };
+
+	// The number of walls placed among the benchmarked projectiles.
+	static int const s_PROJECTILE_WALLS{ 1000 };
+
+	// The number of pool updates per projectile run.
+	static int const s_PROJECTILE_TICKS{ 500 };
+
+	// The thread counts to benchmark the AI tanks with.
+	std::vector<int> m_threadCounts{ 1, 2, 4, 8 };
+
+	// The number of AI tanks in the AI tank runs.
+	static int const s_AI_TANKS{ 1000 };
+
+	// The number of updates per AI tank run.
+	static int const s_AI_TICKS{ 500 };
+
+	// The number of obstacles in the generated level.
+	static int const s_LEVEL_OBSTACLES{ 50000 };
+
+	// The number of times the target is passed in the target passing run.
+	static int const s_TARGET_PASSES{ 1000000 };
+
+	// The number of live particles in the particle run.
+	static int const s_PARTICLES{ 50000 };
+
+	// The number of frames in the particle run.
+	static int const s_PARTICLE_FRAMES{ 500 };
+
+	// The time a frame may spend updating the particles, in milliseconds.
+	static constexpr double s_PARTICLE_BUDGET_MS{ 2.0 };
+
+	// The level with a world larger than the screen.
+	static int const s_LARGE_WORLD_LEVEL{ 2 };
+
+	// The number of complete flow field searches timed per level.
+	static int const s_FLOW_FIELD_SEARCHES{ 50 };
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <SFML/System/Time.hpp>
+
+/// <summary>
+/// @brief A drop-in replacement for sf::Clock that measures simulated time.
+/// 
+/// The clock reads a simulation time value owned by the game, which only advances 
+/// by the fixed update step. Timers built on it behave identically whether the game
+/// runs in real time or as fast as possible in headless mode.
+/// </summary>
+class SimulationClock
+{
+public:
+	/// <summary>
+	/// @brief Starts the clock at the current simulation time.
+	/// </summary>
+	/// <param name="simulationTime">A reference to the total simulated time</param>
+	SimulationClock(sf::Time const & simulationTime);
+
+	/// <summary>
+	/// @brief Gets the simulated time elapsed since the clock was started or last restarted.
+	/// </summary>
+	/// <returns>The elapsed simulated time.</returns>
+	sf::Time getElapsedTime() const;
+
+	/// <summary>
+	/// @brief Restarts the clock from the current simulation time.
+	/// </summary>
+	/// <returns>The simulated time elapsed before the restart.</returns>
+	sf::Time restart();
+
+private:
+	// The total simulated time, advanced by the game each update.
+	sf::Time const & m_simulationTime;
+
+	// The simulation time at which this clock was (re)started.
+	sf::Time m_startTime;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+/// <summary>
+/// @brief The position and rotation of a sprite at the end of an update, kept so drawing can
+///  blend between the previous and the current update.
+/// </summary>
+struct SpriteSnapshot
+{
+	SpriteSnapshot() = default;
+	explicit SpriteSnapshot(sf::Sprite const & sprite);
+
+	sf::Vector2f m_position{ 0.0f, 0.0f };
+	float m_rotation{ 0.0f };
+};
+
+/// <summary>
+/// @brief Everything needed to draw a sprite from the sprite sheet part way between two updates,
+///  copied out of the simulation so it can be drawn while the simulation moves on.
+/// </summary>
+struct SpriteInstance
+{
+	SpriteInstance() = default;
+
+	/// <summary>
+	/// @brief Copies a sprite as of the latest update, and where it was after the update before.
+	/// </summary>
+	SpriteInstance(sf::Sprite const & sprite, SpriteSnapshot const & previous);
+
+	SpriteSnapshot m_previous;
+	SpriteSnapshot m_current;
+	sf::Vector2f m_origin{ 0.0f, 0.0f };
+	sf::Vector2f m_scale{ 1.0f, 1.0f };
+	sf::IntRect m_textureRect;
+	sf::Color m_color{ sf::Color::White };
+};
+
+/// <summary>
+/// @brief Collects many sprites that share one texture into a single vertex array.
+/// 
+/// Each sprite added becomes one textured quad, and the whole batch is drawn with a single
+/// draw call. A batch can be filled once and drawn every frame (static walls), or cleared and
+/// refilled each frame (tanks, projectiles). Clearing keeps the allocated vertex storage, so 
+/// refilling a batch of a similar size does not allocate.
+/// Example usage:
+///		batch.clear();
+///		batch.add(sprite);
+///		window.draw(batch);
+/// </summary>
+class SpriteBatch : public sf::Drawable
+{
+public:
+	/// <summary>
+	/// @brief Default constructor for an empty batch with no texture.
+	/// </summary>
+	SpriteBatch() = default;
+
+	/// <summary>
+	/// @brief Sets the texture shared by every sprite in the batch.
+	/// </summary>
+	/// <param name="texture">A reference to the texture</param>
+	void setTexture(sf::Texture const & texture);
+
+	/// <summary>
+	/// @brief Removes all sprites from the batch.
+	/// </summary>
+	void clear();
+
+	/// <summary>
+	/// @brief Adds a sprite using its current transform, texture rectangle and colour.
+	/// </summary>
+	/// <param name="sprite">The sprite to add, assumed to use the batch texture</param>
+	void add(sf::Sprite const & sprite);
+
+	/// <summary>
+	/// @brief Adds a sprite placed part way between where it was after the previous update and where it is now.
+	/// The rotation turns the short way round, so it does not spin when it wraps past 360 degrees.
+	/// </summary>
+	/// <param name="instance">The sprite to add</param>
+	/// <param name="alpha">How far through the next update the frame is drawn, from 0 (previous) to 1 (current)</param>
+	void add(SpriteInstance const & instance, float alpha);
+
+	/// <summary>
+	/// @brief Adds a textured quad without needing an sf::Sprite.
+	/// </summary>
+	/// <param name="transform">The transform from local quad coordinates to the world</param>
+	/// <param name="textureRect">The area of the texture to show</param>
+	/// <param name="color">The colour to modulate the texture with</param>
+	void add(sf::Transform const & transform, sf::IntRect const & textureRect, sf::Color const & color = sf::Color::White);
+
+	/// <summary>
+	/// @brief Gets the number of sprites in the batch.
+	/// </summary>
+	/// <returns>The sprite count.</returns>
+	int getSpriteCount() const;
+
+private:
+	/// <summary>
+	/// @brief Draws every quad in the batch with one draw call.
+	/// </summary>
+	virtual void draw(sf::RenderTarget & target, sf::RenderStates states) const override;
+
+	// Four vertices per sprite.
+	sf::VertexArray m_vertices{ sf::Quads };
+
+	// The texture shared by every sprite.
+	sf::Texture const * m_texture{ nullptr };
+};
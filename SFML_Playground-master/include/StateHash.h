@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/// <summary>
+/// @brief A 64 bit FNV-1a hash of the bytes of the simulation state.
+///
+/// Values are hashed by their exact bytes, so two states only hash the same if every float
+/// is bit for bit the same. Used to check that a replayed game ends exactly as it was recorded.
+/// Example usage:
+///		StateHash hash;
+///		hash.add(position);
+///		hash.add(health);
+///		std::uint64_t value = hash.getValue();
+/// </summary>
+class StateHash
+{
+public:
+	/// <summary>
+	/// @brief Adds raw bytes to the hash.
+	/// </summary>
+	/// <param name="data">The first byte</param>
+	/// <param name="size">The number of bytes</param>
+	void add(void const * data, std::size_t size);
+
+	/// <summary>
+	/// @brief Adds the bytes of a value to the hash.
+	/// The value must have no padding, or the padding bytes would be hashed too.
+	/// </summary>
+	/// <param name="value">The value</param>
+	template <typename T>
+	void add(T const & value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be hashed by their bytes");
+		add(&value, sizeof(value));
+	}
+
+	/// <summary>
+	/// @brief Gets the hash of everything added so far.
+	/// </summary>
+	/// <returns>The hash value.</returns>
+	std::uint64_t getValue() const;
+
+private:
+	static constexpr std::uint64_t s_OFFSET_BASIS{ 14695981039346656037ull };
+	static constexpr std::uint64_t s_PRIME{ 1099511628211ull };
+
+	std::uint64_t m_value{ s_OFFSET_BASIS };
+};
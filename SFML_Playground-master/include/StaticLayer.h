@@ -0,0 +1,103 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/// <summary>
+/// @brief A cache of everything that never moves (the background and the walls), painted
+///  once into square tiles of render textures and drawn as one textured quad per tile.
+///
+/// Painting the background and every wall each frame costs the same on every frame although
+/// neither changes between levels. A tile is painted the first time it comes into view and
+/// then reused until invalidate() is called, so a frame normally draws only the handful of
+/// tiles covering the view. A world many screens across would need gigabytes to cache whole,
+/// so only a limited number of tiles is kept, and the tile used least recently is painted
+/// over when a new one comes into view. The layer must only be used from the thread that
+/// owns the window, as render textures need its graphics context.
+/// Example usage:
+///		layer.invalidate(); //when the level or its background changes
+///		layer.render(window, viewArea, [&](sf::RenderTarget & target, sf::FloatRect const & area)
+///		{
+///			target.draw(background);
+///			walls.render(target, area);
+///		});
+/// </summary>
+class StaticLayer
+{
+public:
+	/// <summary>
+	/// @brief Paints the part of the static layer in an area, already set up with a view onto that area.
+	/// </summary>
+	using Painter = std::function<void(sf::RenderTarget &, sf::FloatRect const &)>;
+
+	/// <summary>
+	/// @brief Constructor for an empty cache. No render textures are created until tiles come into view.
+	/// </summary>
+	/// <param name="tileSize">The width and height of a tile in pixels</param>
+	/// <param name="maxTiles">The number of tiles kept, more are only made when one view needs them</param>
+	StaticLayer(unsigned tileSize = s_DEFAULT_TILE_SIZE, int maxTiles = s_DEFAULT_MAX_TILES);
+
+	/// <summary>
+	/// @brief Marks every tile as out of date, so each is painted again when next drawn.
+	/// The render textures are kept for reuse.
+	/// </summary>
+	void invalidate();
+
+	/// <summary>
+	/// @brief Draws the tiles covering an area, painting any that are not cached first.
+	/// </summary>
+	/// <param name="target">The render target, with its view already set to the area</param>
+	/// <param name="area">The part of the world being drawn</param>
+	/// <param name="painter">Paints the static layer into a tile that is not cached</param>
+	void render(sf::RenderTarget & target, sf::FloatRect const & area, Painter const & painter);
+
+	/// <summary>
+	/// @brief Gets the number of tiles made so far, painted or not.
+	/// </summary>
+	/// <returns>The tile count.</returns>
+	int getTileCount() const;
+
+private:
+	/// <summary>
+	/// @brief A render texture holding one square of the static layer.
+	/// </summary>
+	struct Tile
+	{
+		std::unique_ptr<sf::RenderTexture> m_texture;
+		int m_column{ 0 };
+		int m_row{ 0 };
+		// False until painted, and again after invalidate().
+		bool m_painted{ false };
+		// The frame the tile was last drawn in, to find the least recently used.
+		std::uint64_t m_lastUsed{ 0 };
+	};
+
+	/// <summary>
+	/// @brief Finds the tile caching a column and row, or paints one that has not been drawn this frame.
+	/// </summary>
+	/// <returns>The tile, painted and ready to draw.</returns>
+	Tile & getTile(int column, int row, Painter const & painter);
+
+	/// <summary>
+	/// @brief Paints a tile's square of the layer into its render texture.
+	/// </summary>
+	void paint(Tile & tile, Painter const & painter);
+
+	// 512 x 512 tiles cover the window with about a dozen quads, and 32 of them take 32 MB.
+	static unsigned const s_DEFAULT_TILE_SIZE{ 512 };
+	static int const s_DEFAULT_MAX_TILES{ 32 };
+
+	unsigned m_tileSize;
+	int m_maxTiles;
+
+	std::vector<Tile> m_tiles;
+
+	// Counts the calls to render, for the least recently used tile.
+	std::uint64_t m_frame{ 0 };
+
+	// Draws a tile's texture, reused for every tile.
+	sf::Sprite m_sprite;
+};
@@ -4,8 +4,13 @@
 #include "CollisionDetector.h"
 #include "ScreenSize.h"
 #include "ProjectilePool.h"
-#include "TankAI.h"
+#include "InputState.h"
+#include "WallGrid.h"
+#include "SpriteBatch.h"
+#include "EffectEvent.h"
+#include "CounterRandom.h"
 
+class AiTankManager;
 
 /// <summary>
 /// @brief A simple tank controller.
@@ -15,11 +20,19 @@
 class Tank
 {
 public:	
-	Tank(sf::Texture const& texture, std::vector<sf::Sprite>& wallSprites);
-	void update(double dt, bool targetsAlive[], int & score, float& accu, TankAi& aiTank);
-	void render(sf::RenderWindow & window);
+	Tank(sf::Texture const& texture, WallGrid const& walls);
+	//moves the tank and its projectiles, adding the hits of its projectiles to events
+	void update(double dt, InputState const& input, bool targetsAlive[], int & score, float& accu, AiTankManager& aiTanks, std::uint32_t tick, CollisionEventBuffer& events);
+	//adds the tank base and turret, as of the previous and the latest update, to the sprites to draw
+	void render(std::vector<SpriteInstance> & sprites) const;
 	void setPosition(sf::Vector2f & pos);
 
+	/// <summary>
+	/// @brief Sets the generator the tank draws its random spawn corners and damage from.
+	/// </summary>
+	/// <param name="random">The generator, copied</param>
+	void setRandom(CounterRandom const& random);
+
 	void takeDamage();
 
 	/// <summary>
@@ -41,7 +54,8 @@ public:
 	/// <summary>
 	/// @brief Processes control keys and applies speed/rotation as appropiate
 	/// </summary>
-	void handleKeyInput();
+	/// <param name="input">The controls held down for this update</param>
+	void handleKeyInput(InputState const& input);
 	/// <summary>
 	/// @brief Increases the rotation by 1 degree, wraps to 0 degrees after 359.
 	/// </summary>
@@ -88,15 +102,41 @@ public:
 	/// </summary>
 	sf::Vector2f getPosition() const;
 
-	sf::Sprite getTurret() const { return m_turret; }
-	sf::Sprite getBase() const { return m_tankBase; }
+	/// <summary>
+	/// @brief Reads the player tank position as of the previous update, for interpolated drawing.
+	/// <returns>The tank base position before the latest update.</returns>
+	/// </summary>
+	sf::Vector2f getLastPosition() const;
+
+	sf::Sprite const& getTurret() const { return m_turret; }
+	sf::Sprite const& getBase() const { return m_tankBase; }
+
+	/// <summary>
+	/// @brief Makes colliders for the tank base and turret without copying the sprites.
+	/// </summary>
+	/// <returns>Views of the current base and turret transforms.</returns>
+	TankColliders getColliders() const;
+
+	/// <summary>
+	/// @brief Gets the visual effects started in the latest update, such as muzzle flashes and dust.
+	/// </summary>
+	/// <returns>The effects, cleared at the start of every update.</returns>
+	std::vector<EffectEvent> const& getEffects() const { return m_effects; }
 
 	int getHealth();
 	void setHealth();
+
+	/// <summary>
+	/// @brief Adds the tank and its projectiles to a hash of the simulation state.
+	/// </summary>
+	/// <param name="hash">The hash to add to</param>
+	void hashState(StateHash & hash) const;
 private:
 	void initSprites(); //function to setup sprites
 	sf::Sprite m_tankBase; //sprite for the tank base
 	sf::Sprite m_turret; //sprite for the turret 
+	SpriteSnapshot m_lastBase; //the tank base as of the previous update, for interpolated drawing
+	SpriteSnapshot m_lastTurret; //the turret as of the previous update, for interpolated drawing
 	sf::Texture const & m_texture; //constand texture vaiable
 
 	double m_speed{ 0.0 }; //variable for the speed of the tank
@@ -107,7 +147,8 @@ private:
 	double m_turretRotation{ 0.0 }; //variable for the rotation of the turret
 	bool m_centeringTurret{ false }; //bool for centering the turret
 	
-	std::vector<sf::Sprite>& m_wallSprites; //a reference vector of sprites for the waals
+	WallGrid const& m_walls; //a reference to the grid of wall sprites
+	std::vector<int> m_nearbyWalls; //indices of the walls near the tank, reused every update
 
 	bool m_enablerotation{ true }; //bool to enable rotation
 	sf::Vector2f m_previousPosition{ 0.0f, 0.0f }; //vector to keep the previous position of the tank
@@ -121,10 +162,25 @@ private:
 	static int const s_TIME_BETWEEN_SHOTS{ 800 };
 	int m_shootTimer{ 800 };
 
-	std::pair<sf::Sprite, sf::Sprite> m_aiTank;
+	std::vector<EffectEvent> m_effects; //the effects started in this update
+	double m_dustDistance{ 0.0 }; //the distance driven since dust was last kicked up
+	static constexpr double s_DUST_SPACING{ 12.0 }; //the distance driven between puffs of dust
 
 	int m_health;
 
+	CounterRandom m_random; //draws from the player's stream, see nextRandom
+	std::uint32_t m_randomDraws{ 0 }; //the number of random numbers drawn so far
+
+	/// <summary>
+	/// @brief Draws the tank's next random number.
+	/// The player only draws in the serial parts of the update (spawning and taking damage),
+	///  so the count of numbers drawn is as repeatable as the tick, and unlike the tick it
+	///  keeps several hits in the same update apart.
+	/// </summary>
+	/// <param name="bound">One past the largest number wanted</param>
+	/// <returns>A number from 0 to bound - 1.</returns>
+	int nextRandom(int bound);
+
 	sf::Sprite topBorder;
 	sf::Sprite bottomBorder;
 	sf::Sprite leftBorder;
@@ -7,9 +7,31 @@
 #include "CollisionDetector.h"
 #include "ScreenSize.h"
 #include "ProjectilePool.h"
+#include "WallGrid.h"
+#include "FlowField.h"
+#include "EffectEvent.h"
+#include "CounterRandom.h"
 
 class Tank;
 
+/// <summary>
+/// @brief The circles the AI tanks steer around, built once per level and shared by every AI tank.
+/// Circle i surrounds wall i, so wall grid query results index the circles too.
+/// </summary>
+struct ObstacleCircles
+{
+	/// <summary>
+	/// @brief Makes a circle around every wall.
+	/// </summary>
+	/// <param name="walls">A reference to the grid of wall sprites</param>
+	void build(WallGrid const & walls);
+
+	std::vector<sf::CircleShape> m_circles;
+
+	// The largest circle radius.
+	float m_maxRadius{ 0.0f };
+};
+
 class TankAi
 {
 public:
@@ -19,33 +41,66 @@ public:
 	///  initialises the steering vector to (0,0) meaning zero force magnitude.
 	/// </summary>
 	/// <param name="texture">A reference to the sprite sheet texture</param>
-	///< param name="wallSprites">A reference to the container of wall sprites</param>
-	TankAi(sf::Texture const & texture, std::vector<sf::Sprite> & wallSprites);
+	///< param name="walls">A reference to the grid of wall sprites</param>
+	TankAi(sf::Texture const & texture, WallGrid const & walls);
 
 	/// <summary>
-	/// @brief Steers the AI tank towards the player tank avoiding obstacles along the way.
-	/// Gets a vector to the player tank and sets steering and velocity vectors towards
-	/// the player if current behaviour is seek. If behaviour is stop, the velocity vector
-	/// is set to 0. Then compute the correct rotation angle to point towards the player tank. 
-	/// If the distance to the player tank is < MAX_SEE_AHEAD, then the behaviour is changed from seek to stop.
-	/// Finally, recalculate the new position of the tank base and turret sprites.
+	/// @brief Runs steer() with the player tank's position and colliders, for when a single AI tank is updated on its own.
 	/// </summary>
 	/// <param name="playerTank">A reference to the player tank</param>
 	/// <param name="dt">update delta time</param>
-	void update(Tank const & playerTank, double dt);
+	/// <param name="tick">The simulation update number, stored in the collision events</param>
+	void update(Tank const & playerTank, double dt, std::uint32_t tick);
 
 	/// <summary>
-	/// @brief Draws the tank base and turret.
-	///
+	/// @brief Steers and moves the tank and updates its projectiles.
+	/// Only changes this tank, and its random patrol points come from its own stream of the
+	///  counter-based generator, so different tanks may be steered on different threads at once
+	///  and in any order. The hits of this tank's projectiles are stored in its own events (see getEvents).
 	/// </summary>
-	/// <param name="window">The SFML Render window</param>
-	void render(sf::RenderWindow & window);
+	/// <param name="playerPosition">The position of the player tank</param>
+	/// <param name="playerColliders">The colliders of the player tank</param>
+	/// <param name="dt">update delta time</param>
+	/// <param name="tick">The simulation update number, stored in the collision events and used to draw random numbers</param>
+	void steer(sf::Vector2f playerPosition, TankColliders const & playerColliders, double dt, std::uint32_t tick);
 
 	/// <summary>
-	/// @brief Initialises the obstacle container and sets the tank base/turret sprites to the specified position.
-	/// <param name="position">An x,y position</param>
+	/// @brief Gets the hits of this tank's projectiles in the last steer.
+	/// </summary>
+	/// <returns>The collision events, with this tank's index as the shooter.</returns>
+	CollisionEventBuffer const & getEvents() const;
+
+	/// <summary>
+	/// @brief Gets the visual effects started in the last steer, such as muzzle flashes and dust.
 	/// </summary>
-	void init(sf::Vector2f position);
+	/// <returns>The effects of this tank.</returns>
+	std::vector<EffectEvent> const & getEffects() const;
+
+	/// <summary>
+	/// @brief Adds the projectiles, tank base and turret, as of the previous and the latest update,
+	///  to the sprites to draw, skipping any outside the area being drawn.
+	/// </summary>
+	/// <param name="sprites">The sprites to draw with the sprite sheet texture</param>
+	/// <param name="area">The part of the world being drawn, grown by the size of a tank</param>
+	void render(std::vector<SpriteInstance> & sprites, sf::FloatRect const & area) const;
+
+	/// <summary>
+	/// @brief Gets the vision cone, drawn as a triangle fan.
+	/// </summary>
+	/// <returns>The vision cone vertices.</returns>
+	sf::VertexArray const & getVision() const;
+
+	/// <summary>
+	/// @brief Stores the obstacles to avoid and the flow field to follow, and sets the tank 
+	///  base/turret sprites to the specified position.
+	/// </summary>
+	/// <param name="position">An x,y position</param>
+	/// <param name="obstacles">The obstacle circles, which must outlive the tank</param>
+	/// <param name="flowField">The flow field leading to the player, nullptr to seek the player directly</param>
+	/// <param name="index">The tank's index, the shooter id of its collision events and its random stream</param>
+	/// <param name="random">The generator the tank draws its patrol points from</param>
+	void init(sf::Vector2f position, ObstacleCircles const & obstacles, FlowField const * flowField, int index,
+		CounterRandom const & random);
 
 
 	/// <summary>
@@ -56,17 +111,46 @@ public:
 	/// <returns>True if collision detected between AI and player tanks.</returns>
 	bool collidesWithPlayer(Tank const& playerTank) const;
 
-	sf::Sprite getBaseSprite();
-	sf::Sprite getTurretSprite();
+	/// <summary>
+	/// @brief Checks for collision between the AI tank and the player tank's bounding boxes.
+	/// </summary>
+	/// <param name="playerBase">The bounding box of the player tank base</param>
+	/// <param name="playerTurret">The bounding box of the player turret</param>
+	/// <returns>True if collision detected between AI and player tanks.</returns>
+	bool collidesWithPlayer(OrientedBoundingBox const& playerBase, OrientedBoundingBox const& playerTurret) const;
+
+	sf::Sprite const & getBaseSprite() const;
+	sf::Sprite const & getTurretSprite() const;
+
+	/// <summary>
+	/// @brief Makes colliders for the tank base and turret without copying the sprites.
+	/// </summary>
+	/// <returns>Views of the current base and turret transforms.</returns>
+	TankColliders getColliders() const;
 
 	void takeDamage();
 	int getHealth();
 
+	/// <summary>
+	/// @brief Adds the tank and its projectiles to a hash of the simulation state.
+	/// </summary>
+	/// <param name="hash">The hash to add to</param>
+	void hashState(StateHash & hash) const;
+
+	/// <summary>
+	/// @brief Builds the vision cone and switches to attacking if the player can be seen.
+	/// s_VISION_RAYS rays are spread across the field of view and each is cut short by the first
+	///  wall it hits, so the cone stops at walls. Only the walls in the grid cells under the cone
+	///  are tested, and each wall only against the rays that pass close to it, so most rays
+	///  test one or two walls. The player is seen if they are within SPOT_DISTANCE, inside the
+	///  field of view, and no wall lies on the line between the tanks.
+	/// Only changes this tank, so it runs in the parallel steer phase with every other tank.
+	/// </summary>
+	/// <param name="t_player">The position of the player tank</param>
 	void lookForPlayer(sf::Vector2f t_player);
 
 	void requestFire();
 
-	bool m_hitTarget{ false };
 private:
 	void initSprites();
 
@@ -76,7 +160,15 @@ private:
 
 	sf::Vector2f collisionAvoidance();
 
-	const sf::CircleShape findMostThreateningObstacle();
+	sf::CircleShape const * findMostThreateningObstacle();
+
+	/// <summary>
+	/// @brief Gets the smallest circle around a wall's bounding box, which every ray that hits the wall passes through.
+	/// </summary>
+	/// <param name="box">The wall's bounding box</param>
+	/// <param name="centre">Set to the centre of the circle</param>
+	/// <param name="radius">Set to the radius of the circle</param>
+	static void getWallCircle(OrientedBoundingBox const & box, sf::Vector2f & centre, float & radius);
 
 	// A reference to the sprite sheet texture.
 	sf::Texture const & m_texture;
@@ -87,8 +179,18 @@ private:
 	// A sprite for the turret
 	sf::Sprite m_turret;
 
-	// A reference to the container of wall sprites.
-	std::vector<sf::Sprite> & m_wallSprites;
+	// The base and turret as of the previous update, for interpolated drawing.
+	SpriteSnapshot m_lastBase;
+	SpriteSnapshot m_lastTurret;
+
+	// A reference to the grid of wall sprites.
+	WallGrid const & m_walls;
+
+	// The indices of the walls near the ahead vector or under the vision cone, reused every update.
+	std::vector<int> m_nearbyWalls;
+
+	// The squared distances and indices of the walls that may be in the vision cone, reused every update.
+	std::vector<std::pair<float, int>> m_visibleWalls;
 
 	// The current rotation as applied to tank base and turret.
 	double m_rotation{ 0.0 };
@@ -118,8 +220,26 @@ private:
 	// The maximum speed for this tank.
 	double const MAX_SPEED{ 50.0 }; //constatnt variable for the max speed of the tank
 
-	// A container of circles that represent the obstacles to avoid.
-	std::vector<sf::CircleShape> m_obstacles;
+	// The circles that represent the obstacles to avoid.
+	ObstacleCircles const * m_obstacles{ nullptr };
+
+	// The player position stored by steer.
+	sf::Vector2f m_playerPosition;
+
+	// The random point drawn by steer while patrolling.
+	sf::Vector2f m_patrolTarget;
+
+	// The time left in milliseconds before a new patrol point is drawn.
+	double m_patrolTime{ 0.0 };
+
+	// The longest time spent heading for one patrol point.
+	static constexpr double PATROL_TIME{ 4000.0 };
+
+	// How close counts as reaching a patrol point.
+	static constexpr float PATROL_REACHED{ 50.0f };
+
+	// The flow field leading to the player, may be nullptr.
+	FlowField const * m_flowField{ nullptr };
 	
 	static float constexpr MASS{ 10.0f };
 
@@ -136,9 +256,26 @@ private:
 
 	double const SPOT_DISTANCE{ 200.0f };
 
+	// The number of rays cast across the field of view, the vision cone has one vertex per ray plus the tip.
+	static int constexpr s_VISION_RAYS{ 21 };
+
+	// The vision cone, tinted by behaviour.
 	sf::VertexArray vision{ sf::TriangleFan };
+	static sf::Color const s_PATROL_VISION;
+	static sf::Color const s_ATTACK_VISION;
 
 	ProjectilePool m_pool;
+
+	// The index of this tank, and the hits of its projectiles in the last steer.
+	int m_index{ 0 };
+	CounterRandom m_random;
+	CollisionEventBuffer m_events;
+
+	// The effects started in the last steer, and the distance driven since dust was last kicked up.
+	std::vector<EffectEvent> m_effects;
+	double m_dustDistance{ 0.0 };
+	static constexpr double s_DUST_SPACING{ 12.0 };
+
 	bool m_fire{ false };
 	static int const s_TIME_BETWEEN_SHOTS{ 1300 };
 	int m_shootTimer{ 1300 };
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <string>
+
+/// <summary>
+/// @brief Lays out many strings in one font and size as glyph quads in a single vertex array.
+///
+/// Glyphs come from the font's own glyph texture, which SFML fills the first time each
+/// character is used at a size and keeps afterwards, so laying out the same characters again
+/// only reads the cached glyphs. Every string added becomes quads in the one vertex array,
+/// each with its own position and colour, and the whole batch is drawn with a single draw call.
+/// Like SpriteBatch, clearing keeps the allocated vertex storage.
+/// Example usage:
+///		batch.clear();
+///		batch.add("Health: 100", sf::Vector2f(700.0f, 0.0f), sf::Color::White);
+///		window.draw(batch);
+/// </summary>
+class TextBatch : public sf::Drawable
+{
+public:
+	/// <summary>
+	/// @brief Constructor that stores the font and character size used for every string.
+	/// </summary>
+	/// <param name="font">A reference to the font, which must outlive the batch</param>
+	/// <param name="characterSize">The character size in pixels</param>
+	TextBatch(sf::Font const & font, unsigned int characterSize = 30);
+
+	/// <summary>
+	/// @brief Removes all text from the batch.
+	/// </summary>
+	void clear();
+
+	/// <summary>
+	/// @brief Adds a string, laid out the same way sf::Text would lay it out.
+	/// </summary>
+	/// <param name="string">The text, which may contain new lines</param>
+	/// <param name="position">The top left of the text</param>
+	/// <param name="color">The fill colour of the text</param>
+	void add(std::string const & string, sf::Vector2f const & position, sf::Color const & color);
+
+private:
+	/// <summary>
+	/// @brief Draws every glyph in the batch with one draw call.
+	/// </summary>
+	virtual void draw(sf::RenderTarget & target, sf::RenderStates states) const override;
+
+	sf::Font const & m_font;
+	unsigned int m_characterSize;
+
+	// Six vertices (two triangles) per glyph.
+	sf::VertexArray m_vertices{ sf::Triangles };
+};
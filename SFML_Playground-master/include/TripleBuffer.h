@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+
+/// <summary>
+/// @brief Passes the latest version of a value from one writer thread to one reader thread without locks.
+///
+/// There are three copies of the value: one the writer fills, one the reader is using, and
+/// one waiting in between. publish() swaps the filled copy with the waiting one, and acquire()
+/// swaps the reader's copy with the waiting one if it is newer, each with a single atomic
+/// exchange. Neither side ever waits for the other: the writer can publish many times while
+/// the reader holds one copy, and the reader keeps the copy it has until a newer one arrives.
+/// The copies are reused, so a value that holds containers keeps their storage.
+/// Example usage:
+///		//writer
+///		fill(buffer.getBack());
+///		buffer.publish();
+///		//reader
+///		draw(buffer.acquire());
+/// </summary>
+template <typename T>
+class TripleBuffer
+{
+public:
+	TripleBuffer() = default;
+
+	TripleBuffer(TripleBuffer const &) = delete;
+	TripleBuffer & operator=(TripleBuffer const &) = delete;
+
+	/// <summary>
+	/// @brief Gets the copy the writer fills. Only the writer thread may call this.
+	/// </summary>
+	/// <returns>The writer's copy, holding whatever was last published from it.</returns>
+	T & getBack() { return m_values[m_back]; }
+
+	/// <summary>
+	/// @brief Hands the writer's copy to the reader. Only the writer thread may call this.
+	/// </summary>
+	void publish()
+	{
+		m_back = m_middle.exchange(m_back | s_NEW, std::memory_order_acq_rel) & s_INDEX;
+	}
+
+	/// <summary>
+	/// @brief Takes the newest published copy, if there is one. Only the reader thread may call this.
+	/// </summary>
+	/// <returns>The reader's copy, which stays valid and unchanged until the next acquire().</returns>
+	T const & acquire()
+	{
+		if (m_middle.load(std::memory_order_relaxed) & s_NEW)
+		{
+			m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & s_INDEX;
+		}
+		return m_values[m_front];
+	}
+
+private:
+	// The waiting copy's index is stored with a flag that is set while it is newer than the reader's.
+	static constexpr int s_INDEX{ 3 };
+	static constexpr int s_NEW{ 4 };
+
+	T m_values[3];
+	int m_back{ 0 };
+	std::atomic<int> m_middle{ 1 };
+	int m_front{ 2 };
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "OrientedBoundingBox.h"
+#include "ScreenSize.h"
+
+/// <summary>
+/// @brief A uniform grid over the static wall sprites for broad-phase collision queries.
+/// 
+/// Walls never move after they are generated, so the grid is built once per level.
+/// Each wall is stored in the single cell that contains the centre of its bounding box
+/// (a "loose" grid), and queries grow the search area by the largest wall half size so
+/// no wall that overlaps the area is missed. Because walls are never stored twice, queries 
+/// need no duplicate removal and are safe to run from several threads at once.
+/// The grid also caches an oriented bounding box per wall, so collision tests against walls
+/// never rebuild them, and holds the size of the level's world, which bounds everything that
+/// moves among the walls.
+/// </summary>
+class WallGrid
+{
+public:
+	/// <summary>
+	/// @brief Constructor that stores a reference to the wall sprites.
+	/// The grid is empty until build() is called.
+	/// </summary>
+	/// <param name="wallSprites">A reference to the container of wall sprites</param>
+	WallGrid(std::vector<sf::Sprite> const & wallSprites);
+
+	/// <summary>
+	/// @brief Sorts the wall sprites into grid cells.
+	/// Must be called again whenever walls are added, removed or moved.
+	/// </summary>
+	/// <param name="cellSize">The width and height of a grid cell in pixels</param>
+	void build(float cellSize = s_DEFAULT_CELL_SIZE);
+
+	/// <summary>
+	/// @brief Finds the walls whose bounding boxes may overlap an area.
+	/// The result may include walls that are close to, but not touching, the area.
+	/// </summary>
+	/// <param name="area">The area to search, in world coordinates</param>
+	/// <param name="result">Cleared and filled with the indices of nearby walls</param>
+	void query(sf::FloatRect const & area, std::vector<int> & result) const;
+
+	/// <summary>
+	/// @brief Gets a wall sprite by index.
+	/// </summary>
+	/// <param name="index">An index returned by query()</param>
+	/// <returns>The wall sprite.</returns>
+	sf::Sprite const & getWall(int index) const;
+
+	/// <summary>
+	/// @brief Gets the cached bounding box of a wall.
+	/// </summary>
+	/// <param name="index">An index returned by query()</param>
+	/// <returns>The oriented bounding box of the wall sprite.</returns>
+	OrientedBoundingBox const & getWallBox(int index) const;
+
+	/// <summary>
+	/// @brief Gets the number of walls.
+	/// </summary>
+	/// <returns>The wall count.</returns>
+	int getWallCount() const;
+
+	/// <summary>
+	/// @brief Sets the size of the world, which runs from (0,0) to (size.x,size.y).
+	/// </summary>
+	/// <param name="size">The world width and height in pixels</param>
+	void setWorldSize(sf::Vector2f const & size);
+
+	/// <summary>
+	/// @brief Gets the size of the world, the screen size unless set.
+	/// </summary>
+	/// <returns>The world width and height in pixels.</returns>
+	sf::Vector2f getWorldSize() const;
+
+private:
+	/// <summary>
+	/// @brief Converts a world position to a cell column and row, clamped to the grid.
+	/// </summary>
+	int getColumn(float x) const;
+	int getRow(float y) const;
+
+	static constexpr float s_DEFAULT_CELL_SIZE{ 64.0f };
+
+	// A reference to the container of wall sprites.
+	std::vector<sf::Sprite> const & m_wallSprites;
+
+	// The world position of the top left corner of the grid.
+	sf::Vector2f m_origin;
+
+	// The width and height of a cell.
+	float m_cellSize{ s_DEFAULT_CELL_SIZE };
+
+	// The grid dimensions in cells.
+	int m_columns{ 0 };
+	int m_rows{ 0 };
+
+	// Half the width and height of the largest wall bounding box.
+	sf::Vector2f m_maxHalfSize;
+
+	// For each cell, the offset of its first wall index in m_cellWalls.
+	// Has one extra entry so the walls of cell i are [m_cellStart[i], m_cellStart[i + 1]).
+	std::vector<int> m_cellStart;
+
+	// The wall indices sorted by cell.
+	std::vector<int> m_cellWalls;
+
+	// The oriented bounding box of each wall, in the same order as the wall sprites.
+	std::vector<OrientedBoundingBox> m_wallBoxes;
+
+	// The width and height of the world.
+	sf::Vector2f m_worldSize{ static_cast<float>(ScreenSize::WIDTH), static_cast<float>(ScreenSize::HEIGHT) };
+};
@@ -0,0 +1,155 @@
+#include "AiTankManager.h"
+#include "Tank.h"
+
+////////////////////////////////////////////////////////////
+AiTankManager::AiTankManager(sf::Texture const & texture, WallGrid const & walls, JobSystem & jobs)
+	: m_texture(texture)
+	, m_walls(walls)
+	, m_jobs(jobs)
+	, m_navigationGrid(walls)
+	, m_flowField(m_navigationGrid)
+{
+}
+
+////////////////////////////////////////////////////////////
+void AiTankManager::init(std::vector<TankData> const & tanks, sf::Vector2f playerPosition, CounterRandom const & random)
+{
+	m_obstacles.build(m_walls);
+	m_navigationGrid.build();
+	m_flowField.reset();
+	m_flowField.buildNow(playerPosition);
+
+	m_tanks.clear();
+	m_tanks.reserve(tanks.size());
+	for (TankData const & tank : tanks)
+	{
+		m_tanks.emplace_back(m_texture, m_walls);
+		m_tanks.back().init(tank.m_position, m_obstacles, &m_flowField, static_cast<int>(m_tanks.size()) - 1, random);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void AiTankManager::update(Tank const & playerTank, double dt, std::uint32_t tick)
+{
+	m_flowField.setGoal(playerTank.getPosition());
+	m_flowField.update();
+
+	// Made here, on one thread, so the player sprites' transforms are up to date before 
+	//  every job reads them.
+	sf::Vector2f playerPosition = playerTank.getPosition();
+	TankColliders playerColliders = playerTank.getColliders();
+
+	m_jobs.parallelFor(static_cast<int>(m_tanks.size()), s_TANKS_PER_JOB, [&](int begin, int end)
+	{
+		for (int i = begin; i < end; i++)
+		{
+			m_tanks[i].steer(playerPosition, playerColliders, dt, tick);
+		}
+	});
+}
+
+////////////////////////////////////////////////////////////
+void AiTankManager::applyDamage(Tank & playerTank)
+{
+	TankColliders playerColliders = playerTank.getColliders();
+	OrientedBoundingBox baseBox = playerColliders.m_base.getBox();
+	OrientedBoundingBox turretBox = playerColliders.m_turret.getBox();
+
+	for (TankAi const & tank : m_tanks)
+	{
+		if (tank.collidesWithPlayer(baseBox, turretBox))
+		{
+			playerTank.takeDamage();
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void AiTankManager::collectEvents(CollisionEventBuffer & events) const
+{
+	for (TankAi const & tank : m_tanks)
+	{
+		events.append(tank.getEvents());
+	}
+}
+
+////////////////////////////////////////////////////////////
+void AiTankManager::collectEffects(std::vector<EffectEvent> & effects) const
+{
+	for (TankAi const & tank : m_tanks)
+	{
+		effects.insert(effects.end(), tank.getEffects().begin(), tank.getEffects().end());
+	}
+}
+
+////////////////////////////////////////////////////////////
+void AiTankManager::render(std::vector<SpriteInstance> & sprites, sf::FloatRect const & area) const
+{
+	for (TankAi const & tank : m_tanks)
+	{
+		tank.render(sprites, area);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void AiTankManager::renderVision(std::vector<sf::Vertex> & vertices, std::vector<int> & sizes, sf::FloatRect const & area) const
+{
+	for (TankAi const & tank : m_tanks)
+	{
+		sf::VertexArray const & vision = tank.getVision();
+		if (!area.intersects(vision.getBounds()))
+		{
+			continue;
+		}
+		for (std::size_t i = 0; i < vision.getVertexCount(); i++)
+		{
+			vertices.push_back(vision[i]);
+		}
+		sizes.push_back(static_cast<int>(vision.getVertexCount()));
+	}
+}
+
+////////////////////////////////////////////////////////////
+std::vector<TankColliders> const & AiTankManager::getColliders()
+{
+	m_colliders.clear();
+	for (TankAi const & tank : m_tanks)
+	{
+		m_colliders.push_back(tank.getColliders());
+	}
+	return m_colliders;
+}
+
+////////////////////////////////////////////////////////////
+void AiTankManager::takeDamage(int index)
+{
+	m_tanks[index].takeDamage();
+}
+
+////////////////////////////////////////////////////////////
+void AiTankManager::hashState(StateHash & hash) const
+{
+	hash.add(getCount());
+	for (TankAi const & tank : m_tanks)
+	{
+		tank.hashState(hash);
+	}
+}
+
+////////////////////////////////////////////////////////////
+int AiTankManager::getCount() const
+{
+	return static_cast<int>(m_tanks.size());
+}
+
+////////////////////////////////////////////////////////////
+FlowField const & AiTankManager::getFlowField() const
+{
+	return m_flowField;
+}
+
+////////////////////////////////////////////////////////////
+TankAi const & AiTankManager::getTank(int index) const
+{
+	return m_tanks[index];
+}
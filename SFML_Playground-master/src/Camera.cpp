@@ -0,0 +1,50 @@
+#include "Camera.h"
+#include <algorithm>
+
+////////////////////////////////////////////////////////////
+Camera::Camera(sf::Vector2f viewSize)
+	: m_viewSize(viewSize)
+	, m_worldSize(viewSize)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Camera::setWorldSize(sf::Vector2f const & worldSize)
+{
+	m_worldSize = worldSize;
+}
+
+////////////////////////////////////////////////////////////
+sf::Vector2f Camera::getCentre(sf::Vector2f target) const
+{
+	return sf::Vector2f(clampAxis(target.x, m_viewSize.x, m_worldSize.x), clampAxis(target.y, m_viewSize.y, m_worldSize.y));
+}
+
+////////////////////////////////////////////////////////////
+sf::FloatRect Camera::getArea(sf::Vector2f centre) const
+{
+	return sf::FloatRect(centre - m_viewSize / 2.0f, m_viewSize);
+}
+
+////////////////////////////////////////////////////////////
+sf::View Camera::getView(sf::Vector2f centre) const
+{
+	return sf::View(centre, m_viewSize);
+}
+
+////////////////////////////////////////////////////////////
+sf::Vector2f const & Camera::getViewSize() const
+{
+	return m_viewSize;
+}
+
+////////////////////////////////////////////////////////////
+float Camera::clampAxis(float target, float view, float world)
+{
+	if (world <= view)
+	{
+		return world / 2.0f;
+	}
+
+	return std::clamp(target, view / 2.0f, world - view / 2.0f);
+}
@@ -0,0 +1,90 @@
+#include "ChunkedSpriteBatch.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+////////////////////////////////////////////////////////////
+void ChunkedSpriteBatch::setTexture(sf::Texture const & texture)
+{
+	m_texture = &texture;
+	for (SpriteBatch & chunk : m_chunks)
+	{
+		chunk.setTexture(texture);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void ChunkedSpriteBatch::build(std::vector<sf::Sprite> const & sprites, sf::Vector2f const & worldSize, float chunkSize)
+{
+	m_chunkSize = chunkSize;
+	m_columns = std::max(1, static_cast<int>(std::ceil(worldSize.x / m_chunkSize)));
+	m_rows = std::max(1, static_cast<int>(std::ceil(worldSize.y / m_chunkSize)));
+	m_maxHalfSize = sf::Vector2f(0.0f, 0.0f);
+
+	// Clearing keeps the storage of chunks the last level also had.
+	m_chunks.resize(m_columns * m_rows);
+	for (SpriteBatch & chunk : m_chunks)
+	{
+		chunk.clear();
+		if (m_texture)
+		{
+			chunk.setTexture(*m_texture);
+		}
+	}
+
+	for (sf::Sprite const & sprite : sprites)
+	{
+		sf::FloatRect bounds = sprite.getGlobalBounds();
+		m_maxHalfSize.x = std::max(m_maxHalfSize.x, bounds.width / 2.0f);
+		m_maxHalfSize.y = std::max(m_maxHalfSize.y, bounds.height / 2.0f);
+
+		sf::Vector2f centre(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height / 2.0f);
+		int column = std::clamp(static_cast<int>(std::floor(centre.x / m_chunkSize)), 0, m_columns - 1);
+		int row = std::clamp(static_cast<int>(std::floor(centre.y / m_chunkSize)), 0, m_rows - 1);
+		m_chunks[row * m_columns + column].add(sprite);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void ChunkedSpriteBatch::render(sf::RenderTarget & target, sf::FloatRect const & area) const
+{
+	if (m_chunks.empty())
+	{
+		return;
+	}
+
+	// A sprite is filed under its centre, so it can reach into the area from a chunk just outside it.
+	float left = area.left - m_maxHalfSize.x;
+	float top = area.top - m_maxHalfSize.y;
+	float right = area.left + area.width + m_maxHalfSize.x;
+	float bottom = area.top + area.height + m_maxHalfSize.y;
+
+	int firstColumn = std::clamp(static_cast<int>(std::floor(left / m_chunkSize)), 0, m_columns - 1);
+	int lastColumn = std::clamp(static_cast<int>(std::floor(right / m_chunkSize)), 0, m_columns - 1);
+	int firstRow = std::clamp(static_cast<int>(std::floor(top / m_chunkSize)), 0, m_rows - 1);
+	int lastRow = std::clamp(static_cast<int>(std::floor(bottom / m_chunkSize)), 0, m_rows - 1);
+
+	for (int row = firstRow; row <= lastRow; row++)
+	{
+		for (int column = firstColumn; column <= lastColumn; column++)
+		{
+			SpriteBatch const & chunk = m_chunks[row * m_columns + column];
+			if (chunk.getSpriteCount() > 0)
+			{
+				target.draw(chunk);
+				Profiler::count(ProfileCounter::DRAW_CALLS);
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+int ChunkedSpriteBatch::getSpriteCount() const
+{
+	int count = 0;
+	for (SpriteBatch const & chunk : m_chunks)
+	{
+		count += chunk.getSpriteCount();
+	}
+	return count;
+}
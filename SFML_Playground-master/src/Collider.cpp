@@ -0,0 +1,21 @@
+#include "Collider.h"
+
+////////////////////////////////////////////////////////////
+Collider::Collider(sf::Sprite const & sprite)
+	: m_transform(&sprite.getTransform())
+	, m_size(sprite.getLocalBounds().width, sprite.getLocalBounds().height)
+{
+}
+
+////////////////////////////////////////////////////////////
+Collider::Collider(sf::Transform const & transform, sf::Vector2f const & size)
+	: m_transform(&transform)
+	, m_size(size)
+{
+}
+
+////////////////////////////////////////////////////////////
+OrientedBoundingBox Collider::getBox() const
+{
+	return OrientedBoundingBox(*m_transform, m_size);
+}
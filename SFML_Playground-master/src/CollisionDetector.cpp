@@ -1,28 +1,35 @@
 #include "CollisionDetector.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
 
 bool CollisionDetector::collision(const sf::Sprite& object1, const sf::Sprite& object2) {
 	OrientedBoundingBox OBB1(object1);
 	OrientedBoundingBox OBB2(object2);
 
-	// Create the four distinct axes that are perpendicular to the edges of the two rectangles
-	sf::Vector2f Axes[4] = {
-		sf::Vector2f(OBB1.Points[1].x - OBB1.Points[0].x,
-		OBB1.Points[1].y - OBB1.Points[0].y),
-		sf::Vector2f(OBB1.Points[1].x - OBB1.Points[2].x,
-		OBB1.Points[1].y - OBB1.Points[2].y),
-		sf::Vector2f(OBB2.Points[0].x - OBB2.Points[3].x,
-		OBB2.Points[0].y - OBB2.Points[3].y),
-		sf::Vector2f(OBB2.Points[0].x - OBB2.Points[1].x,
-		OBB2.Points[0].y - OBB2.Points[1].y)
-	};
+	return collision(OBB1, OBB2);
+}
+
+bool CollisionDetector::collision(const OrientedBoundingBox& OBB1, const OrientedBoundingBox& OBB2) {
+	Profiler::count(ProfileCounter::COLLISION_TESTS);
+
+	// Cheap rejection: if the enclosing rectangles do not overlap, neither do the boxes
+	if (OBB2.Bounds.left > OBB1.Bounds.left + OBB1.Bounds.width ||
+		OBB1.Bounds.left > OBB2.Bounds.left + OBB2.Bounds.width ||
+		OBB2.Bounds.top > OBB1.Bounds.top + OBB1.Bounds.height ||
+		OBB1.Bounds.top > OBB2.Bounds.top + OBB2.Bounds.height)
+		return false;
+
+	// The four distinct axes that are perpendicular to the edges of the two rectangles
+	const sf::Vector2f* Axes[4] = { &OBB1.Axes[0], &OBB1.Axes[1], &OBB2.Axes[0], &OBB2.Axes[1] };
 
 	for (int i = 0; i<4; i++) // For each axis...
 	{
 		float MinOBB1, MaxOBB1, MinOBB2, MaxOBB2;
 
 		// ... project the points of both OBBs onto the axis ...
-		OBB1.ProjectOntoAxis(Axes[i], MinOBB1, MaxOBB1);
-		OBB2.ProjectOntoAxis(Axes[i], MinOBB2, MaxOBB2);
+		OBB1.ProjectOntoAxis(*Axes[i], MinOBB1, MaxOBB1);
+		OBB2.ProjectOntoAxis(*Axes[i], MinOBB2, MaxOBB2);
 
 		// ... and check whether the outermost projected points of both OBBs overlap.
 		// If this is not the case, the Seperating Axis Theorem states that there can be no collision between the rectangles
@@ -32,3 +39,107 @@ bool CollisionDetector::collision(const sf::Sprite& object1, const sf::Sprite& o
 
 	return true;	// Collision detected!
 }
+
+bool CollisionDetector::sweep(const OrientedBoundingBox& Moving, const sf::Vector2f& Movement, const OrientedBoundingBox& Still, float& Time) {
+	Profiler::count(ProfileCounter::COLLISION_TESTS);
+
+	// Cheap rejection: if the rectangle passed over does not overlap the still box's, nothing is hit
+	sf::FloatRect Swept = sweptBounds(Moving, Movement);
+	if (Still.Bounds.left > Swept.left + Swept.width ||
+		Swept.left > Still.Bounds.left + Still.Bounds.width ||
+		Still.Bounds.top > Swept.top + Swept.height ||
+		Swept.top > Still.Bounds.top + Still.Bounds.height)
+		return false;
+
+	const sf::Vector2f* Axes[4] = { &Moving.Axes[0], &Moving.Axes[1], &Still.Axes[0], &Still.Axes[1] };
+
+	float First = 0.f; // The latest time the projections start to overlap on any axis
+	float Last = 1.f; // The earliest time they stop overlapping on any axis
+
+	for (int i = 0; i<4; i++) // For each axis...
+	{
+		float MinMoving, MaxMoving, MinStill, MaxStill;
+		Moving.ProjectOntoAxis(*Axes[i], MinMoving, MaxMoving);
+		Still.ProjectOntoAxis(*Axes[i], MinStill, MaxStill);
+
+		float Speed = Movement.x*Axes[i]->x + Movement.y*Axes[i]->y;
+
+		if (Speed == 0.f)
+		{
+			// Not moving along this axis, so the projections overlap for the whole move or not at all
+			if (!((MinStill <= MaxMoving) && (MaxStill >= MinMoving)))
+				return false;
+			continue;
+		}
+
+		// ... find when the moving projection's leading edge reaches the still one and when its trailing edge leaves ...
+		float Enter = (Speed > 0.f ? MinStill - MaxMoving : MaxStill - MinMoving) / Speed;
+		float Leave = (Speed > 0.f ? MaxStill - MinMoving : MinStill - MaxMoving) / Speed;
+
+		First = std::max(First, Enter);
+		Last = std::min(Last, Leave);
+
+		// ... and if they never overlap on every axis at once, the boxes do not touch
+		if (First > Last)
+			return false;
+	}
+
+	Time = First;
+	return true;	// Collision detected!
+}
+
+bool CollisionDetector::rayCast(const sf::Vector2f& Origin, const sf::Vector2f& Ray, const OrientedBoundingBox& Box, float& Time) {
+	Profiler::count(ProfileCounter::COLLISION_TESTS);
+
+	// Cheap rejection: if the rectangle enclosing the segment does not overlap the box's, nothing is hit
+	float Left = std::min(Origin.x, Origin.x + Ray.x);
+	float Top = std::min(Origin.y, Origin.y + Ray.y);
+	if (Box.Bounds.left > Left + std::abs(Ray.x) ||
+		Left > Box.Bounds.left + Box.Bounds.width ||
+		Box.Bounds.top > Top + std::abs(Ray.y) ||
+		Top > Box.Bounds.top + Box.Bounds.height)
+		return false;
+
+	float First = 0.f; // The latest time the segment enters the box's projection on either axis
+	float Last = 1.f; // The earliest time it leaves
+
+	for (int i = 0; i<2; i++) // For each of the box's axes...
+	{
+		// ... the box's own projection is the slab, cached with the box ...
+		float Start = Origin.x*Box.Axes[i].x + Origin.y*Box.Axes[i].y;
+		float Speed = Ray.x*Box.Axes[i].x + Ray.y*Box.Axes[i].y;
+
+		if (Speed == 0.f)
+		{
+			// Parallel to the slab, so the segment is inside it for its whole length or not at all
+			if (Start < Box.AxisMin[i] || Start > Box.AxisMax[i])
+				return false;
+			continue;
+		}
+
+		// ... find when the point enters the slab and when it leaves ...
+		float Enter = ((Speed > 0.f ? Box.AxisMin[i] : Box.AxisMax[i]) - Start) / Speed;
+		float Leave = ((Speed > 0.f ? Box.AxisMax[i] : Box.AxisMin[i]) - Start) / Speed;
+
+		First = std::max(First, Enter);
+		Last = std::min(Last, Leave);
+
+		// ... and if it is never inside both slabs at once, it misses the box
+		if (First > Last)
+			return false;
+	}
+
+	Time = First;
+	return true;	// Hit!
+}
+
+sf::FloatRect CollisionDetector::sweptBounds(const OrientedBoundingBox& Moving, const sf::Vector2f& Movement) {
+	sf::FloatRect Swept = Moving.Bounds;
+	if (Movement.x < 0.f)
+		Swept.left += Movement.x;
+	if (Movement.y < 0.f)
+		Swept.top += Movement.y;
+	Swept.width += std::abs(Movement.x);
+	Swept.height += std::abs(Movement.y);
+	return Swept;
+}
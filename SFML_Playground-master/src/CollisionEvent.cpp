@@ -0,0 +1,49 @@
+#include "CollisionEvent.h"
+
+////////////////////////////////////////////////////////////
+CollisionEventBuffer::CollisionEventBuffer(int capacity)
+{
+	m_events.reserve(capacity);
+}
+
+////////////////////////////////////////////////////////////
+void CollisionEventBuffer::clear()
+{
+	m_events.clear();
+}
+
+////////////////////////////////////////////////////////////
+void CollisionEventBuffer::add(CollisionEvent const & event)
+{
+	m_events.push_back(event);
+}
+
+////////////////////////////////////////////////////////////
+void CollisionEventBuffer::append(CollisionEventBuffer const & events)
+{
+	m_events.insert(m_events.end(), events.m_events.begin(), events.m_events.end());
+}
+
+////////////////////////////////////////////////////////////
+int CollisionEventBuffer::getCount() const
+{
+	return static_cast<int>(m_events.size());
+}
+
+////////////////////////////////////////////////////////////
+std::vector<CollisionEvent>::const_iterator CollisionEventBuffer::begin() const
+{
+	return m_events.begin();
+}
+
+////////////////////////////////////////////////////////////
+std::vector<CollisionEvent>::const_iterator CollisionEventBuffer::end() const
+{
+	return m_events.end();
+}
+
+////////////////////////////////////////////////////////////
+CollisionEvent & CollisionEventBuffer::operator[](int index)
+{
+	return m_events[index];
+}
@@ -0,0 +1,311 @@
+#include "CompiledLevel.h"
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static char const s_MAGIC[4] = { 'T', 'L', 'V', 'L' };
+
+////////////////////////////////////////////////////////////
+CompiledLevel::~CompiledLevel()
+{
+	close();
+}
+
+////////////////////////////////////////////////////////////
+void CompiledLevel::open(std::string const & fileName)
+{
+	close();
+
+	// Map the whole file read-only. The file and mapping handles can be closed straight
+	//  away, the view keeps the mapping alive until it is unmapped.
+#ifdef _WIN32
+	HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file != INVALID_HANDLE_VALUE)
+	{
+		LARGE_INTEGER size;
+		if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+		{
+			HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping != nullptr)
+			{
+				m_data = static_cast<char const *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+				m_size = static_cast<std::size_t>(size.QuadPart);
+				CloseHandle(mapping);
+			}
+		}
+		CloseHandle(file);
+	}
+#else
+	int file = ::open(fileName.c_str(), O_RDONLY);
+	if (file != -1)
+	{
+		struct stat status;
+		if (fstat(file, &status) == 0 && status.st_size > 0)
+		{
+			void * data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+			if (data != MAP_FAILED)
+			{
+				m_data = static_cast<char const *>(data);
+				m_size = static_cast<std::size_t>(status.st_size);
+			}
+		}
+		::close(file);
+	}
+#endif
+
+	if (m_data == nullptr)
+	{
+		m_size = 0;
+		std::string message("File: " + fileName + " could not be mapped");
+		throw std::exception(message.c_str());
+	}
+
+	if (m_size < sizeof(CompiledLevelHeader) ||
+		std::memcmp(getHeader().m_magic, s_MAGIC, sizeof(s_MAGIC)) != 0 ||
+		getHeader().m_version != s_VERSION)
+	{
+		close();
+		std::string message("File: " + fileName + " is not a compiled level of version " + std::to_string(s_VERSION));
+		throw std::exception(message.c_str());
+	}
+
+	// Check every section once here, so the getters never need to.
+	try
+	{
+		CompiledLevelHeader const & header = getHeader();
+		checkRange(header.m_background.m_offset, header.m_background.m_length);
+		checkRange(header.m_typeNames.m_offset, std::uint64_t(header.m_typeNames.m_count) * sizeof(CompiledString));
+		checkRange(header.m_obstacles.m_offset, std::uint64_t(header.m_obstacles.m_count) * sizeof(CompiledObstacle));
+		checkRange(header.m_targets.m_offset, std::uint64_t(header.m_targets.m_count) * sizeof(CompiledTarget));
+		checkRange(header.m_aiTanks.m_offset, std::uint64_t(header.m_aiTanks.m_count) * sizeof(CompiledTank));
+		for (CompiledString const & name : getSection<CompiledString>(header.m_typeNames))
+		{
+			checkRange(name.m_offset, name.m_length);
+		}
+		for (CompiledObstacle const & obstacle : getObstacles())
+		{
+			if (obstacle.m_type >= header.m_typeNames.m_count)
+			{
+				throw std::exception("obstacle type out of range");
+			}
+		}
+		if (!(header.m_world.m_width > 0.0f && header.m_world.m_height > 0.0f))
+		{
+			throw std::exception("world size not positive");
+		}
+	}
+	catch (std::exception& e)
+	{
+		close();
+		std::string message("File: " + fileName + " is damaged: " + e.what());
+		throw std::exception(message.c_str());
+	}
+}
+
+////////////////////////////////////////////////////////////
+void CompiledLevel::close()
+{
+	if (m_data != nullptr)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(m_data);
+#else
+		munmap(const_cast<char *>(m_data), m_size);
+#endif
+		m_data = nullptr;
+		m_size = 0;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void CompiledLevel::write(LevelData const & level, std::string const & fileName)
+{
+	// Obstacle types are stored once each and referred to by index.
+	std::vector<std::string> typeNames;
+	std::vector<CompiledObstacle> obstacles;
+	obstacles.reserve(level.m_obstacles.size());
+	for (ObstacleData const & obstacle : level.m_obstacles)
+	{
+		std::uint32_t type = 0;
+		while (type < typeNames.size() && typeNames[type] != obstacle.m_type)
+		{
+			type++;
+		}
+		if (type == typeNames.size())
+		{
+			typeNames.push_back(obstacle.m_type);
+		}
+		obstacles.push_back(CompiledObstacle{ type, obstacle.m_position.x, obstacle.m_position.y, static_cast<float>(obstacle.m_rotation) });
+	}
+
+	std::vector<CompiledTarget> targets;
+	targets.reserve(level.m_targets.size());
+	for (TargetData const & target : level.m_targets)
+	{
+		targets.push_back(CompiledTarget{ target.m_position.x, target.m_position.y, target.m_randomOffset, 
+			static_cast<float>(target.m_rotation), target.m_spawnTime });
+	}
+
+	std::vector<CompiledTank> aiTanks;
+	aiTanks.reserve(level.m_aiTanks.size());
+	for (TankData const & aiTank : level.m_aiTanks)
+	{
+		aiTanks.push_back(CompiledTank{ aiTank.m_position.x, aiTank.m_position.y });
+	}
+
+	// The header, then the record arrays, then the characters of every string.
+	CompiledLevelHeader header;
+	std::memcpy(header.m_magic, s_MAGIC, sizeof(s_MAGIC));
+	header.m_version = s_VERSION;
+	header.m_world = CompiledSize{ level.m_world.m_size.x, level.m_world.m_size.y };
+	header.m_tank = CompiledTank{ level.m_tank.m_position.x, level.m_tank.m_position.y };
+
+	std::uint32_t offset = sizeof(CompiledLevelHeader);
+	header.m_typeNames = CompiledSection{ offset, static_cast<std::uint32_t>(typeNames.size()) };
+	offset += static_cast<std::uint32_t>(typeNames.size() * sizeof(CompiledString));
+	header.m_obstacles = CompiledSection{ offset, static_cast<std::uint32_t>(obstacles.size()) };
+	offset += static_cast<std::uint32_t>(obstacles.size() * sizeof(CompiledObstacle));
+	header.m_targets = CompiledSection{ offset, static_cast<std::uint32_t>(targets.size()) };
+	offset += static_cast<std::uint32_t>(targets.size() * sizeof(CompiledTarget));
+	header.m_aiTanks = CompiledSection{ offset, static_cast<std::uint32_t>(aiTanks.size()) };
+	offset += static_cast<std::uint32_t>(aiTanks.size() * sizeof(CompiledTank));
+
+	std::string strings = level.m_background.m_fileName;
+	header.m_background = CompiledString{ offset, static_cast<std::uint32_t>(strings.size()) };
+	std::vector<CompiledString> names;
+	for (std::string const & typeName : typeNames)
+	{
+		names.push_back(CompiledString{ offset + static_cast<std::uint32_t>(strings.size()), static_cast<std::uint32_t>(typeName.size()) });
+		strings += typeName;
+	}
+
+	std::ofstream outputFile(fileName, std::ios::binary | std::ios::trunc);
+	if (!outputFile.is_open())
+	{
+		std::string message("File: " + fileName + " could not be written");
+		throw std::exception(message.c_str());
+	}
+	outputFile.write(reinterpret_cast<char const *>(&header), sizeof(header));
+	outputFile.write(reinterpret_cast<char const *>(names.data()), names.size() * sizeof(CompiledString));
+	outputFile.write(reinterpret_cast<char const *>(obstacles.data()), obstacles.size() * sizeof(CompiledObstacle));
+	outputFile.write(reinterpret_cast<char const *>(targets.data()), targets.size() * sizeof(CompiledTarget));
+	outputFile.write(reinterpret_cast<char const *>(aiTanks.data()), aiTanks.size() * sizeof(CompiledTank));
+	outputFile.write(strings.data(), strings.size());
+	if (!outputFile)
+	{
+		std::string message("File: " + fileName + " could not be written");
+		throw std::exception(message.c_str());
+	}
+}
+
+////////////////////////////////////////////////////////////
+void CompiledLevel::toLevelData(LevelData & level) const
+{
+	level.m_background.m_fileName = getBackground();
+	level.m_world.m_size = sf::Vector2f(getWorld().m_width, getWorld().m_height);
+	level.m_tank.m_position = sf::Vector2f(getTank().m_x, getTank().m_y);
+
+	std::vector<std::string> typeNames;
+	for (std::uint32_t type = 0; type < getHeader().m_typeNames.m_count; type++)
+	{
+		typeNames.push_back(getTypeName(type));
+	}
+
+	ArrayView<CompiledObstacle> obstacles = getObstacles();
+	level.m_obstacles.resize(obstacles.size());
+	for (std::size_t i = 0; i < obstacles.size(); i++)
+	{
+		ObstacleData & obstacle = level.m_obstacles[i];
+		obstacle.m_type = typeNames[obstacles[i].m_type];
+		obstacle.m_position = sf::Vector2f(obstacles[i].m_x, obstacles[i].m_y);
+		obstacle.m_rotation = obstacles[i].m_rotation;
+	}
+
+	ArrayView<CompiledTarget> targets = getTargets();
+	level.m_targets.resize(targets.size());
+	for (std::size_t i = 0; i < targets.size(); i++)
+	{
+		TargetData & target = level.m_targets[i];
+		target.m_position = sf::Vector2f(targets[i].m_x, targets[i].m_y);
+		target.m_randomOffset = targets[i].m_randomOffset;
+		target.m_rotation = targets[i].m_rotation;
+		target.m_spawnTime = targets[i].m_spawnTime;
+	}
+
+	ArrayView<CompiledTank> aiTanks = getAiTanks();
+	level.m_aiTanks.resize(aiTanks.size());
+	for (std::size_t i = 0; i < aiTanks.size(); i++)
+	{
+		level.m_aiTanks[i].m_position = sf::Vector2f(aiTanks[i].m_x, aiTanks[i].m_y);
+	}
+}
+
+////////////////////////////////////////////////////////////
+std::string CompiledLevel::getBackground() const
+{
+	CompiledString const & background = getHeader().m_background;
+	return std::string(m_data + background.m_offset, background.m_length);
+}
+
+////////////////////////////////////////////////////////////
+CompiledSize const & CompiledLevel::getWorld() const
+{
+	return getHeader().m_world;
+}
+
+////////////////////////////////////////////////////////////
+CompiledTank const & CompiledLevel::getTank() const
+{
+	return getHeader().m_tank;
+}
+
+////////////////////////////////////////////////////////////
+ArrayView<CompiledObstacle> CompiledLevel::getObstacles() const
+{
+	return getSection<CompiledObstacle>(getHeader().m_obstacles);
+}
+
+////////////////////////////////////////////////////////////
+ArrayView<CompiledTarget> CompiledLevel::getTargets() const
+{
+	return getSection<CompiledTarget>(getHeader().m_targets);
+}
+
+////////////////////////////////////////////////////////////
+ArrayView<CompiledTank> CompiledLevel::getAiTanks() const
+{
+	return getSection<CompiledTank>(getHeader().m_aiTanks);
+}
+
+////////////////////////////////////////////////////////////
+std::string CompiledLevel::getTypeName(std::uint32_t type) const
+{
+	CompiledString const & name = getSection<CompiledString>(getHeader().m_typeNames)[type];
+	return std::string(m_data + name.m_offset, name.m_length);
+}
+
+////////////////////////////////////////////////////////////
+void CompiledLevel::checkRange(std::uint32_t offset, std::uint64_t bytes) const
+{
+	if (offset > m_size || bytes > m_size - offset)
+	{
+		throw std::exception("section outside the file");
+	}
+}
+
+////////////////////////////////////////////////////////////
+CompiledLevelHeader const & CompiledLevel::getHeader() const
+{
+	return *reinterpret_cast<CompiledLevelHeader const *>(m_data);
+}
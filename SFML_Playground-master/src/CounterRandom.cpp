@@ -0,0 +1,43 @@
+#include "CounterRandom.h"
+
+////////////////////////////////////////////////////////////
+CounterRandom::CounterRandom(std::uint32_t seed)
+	: m_seed(seed)
+{
+}
+
+////////////////////////////////////////////////////////////
+std::uint32_t CounterRandom::getSeed() const
+{
+	return m_seed;
+}
+
+////////////////////////////////////////////////////////////
+std::uint32_t CounterRandom::get(std::uint32_t stream, std::uint32_t counter, std::uint32_t index) const
+{
+	// Mixing the key twice keeps neighbouring counters and indices from giving related numbers.
+	std::uint64_t key = (static_cast<std::uint64_t>(stream) << 32) | counter;
+	std::uint64_t salt = mix((static_cast<std::uint64_t>(m_seed) << 32) | index);
+	return static_cast<std::uint32_t>(mix(key ^ salt) >> 32);
+}
+
+////////////////////////////////////////////////////////////
+int CounterRandom::getInt(int bound, std::uint32_t stream, std::uint32_t counter, std::uint32_t index) const
+{
+	if (bound <= 0)
+	{
+		return 0;
+	}
+
+	// Scaling the 32 bit number into the range, which unlike % has no bias towards small numbers worth noticing.
+	return static_cast<int>((static_cast<std::uint64_t>(get(stream, counter, index)) * static_cast<std::uint32_t>(bound)) >> 32);
+}
+
+////////////////////////////////////////////////////////////
+std::uint64_t CounterRandom::mix(std::uint64_t value)
+{
+	value += 0x9E3779B97F4A7C15ull;
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+	return value ^ (value >> 31);
+}
@@ -0,0 +1,102 @@
+#include "EffectSystem.h"
+#include "MathUtility.h"
+#include <cmath>
+
+////////////////////////////////////////////////////////////
+EffectSystem::EffectSystem(int budget)
+	: m_particles(budget)
+{
+}
+
+////////////////////////////////////////////////////////////
+void EffectSystem::setTexture(sf::Texture const & texture, sf::IntRect const & sparks, sf::IntRect const & dust)
+{
+	m_particles.setTexture(texture);
+	m_flashStyle = m_particles.addStyle(ParticleStyle{ sparks, sf::Color(255, 230, 150), 14.0f, 4.0f });
+	m_sparkStyle = m_particles.addStyle(ParticleStyle{ sparks, sf::Color(255, 200, 80), 6.0f, 2.0f });
+	m_hitStyle = m_particles.addStyle(ParticleStyle{ sparks, sf::Color(255, 120, 40), 10.0f, 3.0f });
+	m_dustStyle = m_particles.addStyle(ParticleStyle{ dust, sf::Color(160, 140, 110, 140), 8.0f, 22.0f });
+	m_smokeStyle = m_particles.addStyle(ParticleStyle{ dust, sf::Color(90, 90, 90, 160), 10.0f, 28.0f });
+}
+
+////////////////////////////////////////////////////////////
+void EffectSystem::emit(EffectEvent const & event)
+{
+	switch (event.m_type)
+	{
+	case EffectType::MUZZLE_FLASH:
+		burst(m_flashStyle, event.m_position, event.m_rotation, 30.0f, 150.0f, 300.0f, 0.12f, 8);
+		break;
+	case EffectType::WALL_IMPACT:
+		burst(m_sparkStyle, event.m_position, event.m_rotation, 360.0f, 80.0f, 220.0f, 0.3f, 12);
+		burst(m_dustStyle, event.m_position, event.m_rotation, 360.0f, 20.0f, 60.0f, 0.6f, 6);
+		break;
+	case EffectType::TANK_IMPACT:
+		burst(m_hitStyle, event.m_position, event.m_rotation, 360.0f, 100.0f, 260.0f, 0.35f, 16);
+		burst(m_smokeStyle, event.m_position, event.m_rotation, 360.0f, 15.0f, 45.0f, 0.8f, 8);
+		break;
+	case EffectType::DUST:
+		// Kicked up behind the tank, drifting away from the way it is driving.
+		burst(m_dustStyle, event.m_position, event.m_rotation + 180.0f, 90.0f, 10.0f, 40.0f, 0.8f, 2);
+		break;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void EffectSystem::update(float seconds)
+{
+	m_particles.update(seconds);
+}
+
+////////////////////////////////////////////////////////////
+void EffectSystem::clear()
+{
+	m_particles.clear();
+}
+
+////////////////////////////////////////////////////////////
+int EffectSystem::getParticleCount() const
+{
+	return m_particles.getActiveCount();
+}
+
+////////////////////////////////////////////////////////////
+void EffectSystem::burst(int style, sf::Vector2f const & position, float direction, float spread,
+	float minSpeed, float maxSpeed, float lifetime, int count)
+{
+	std::uniform_real_distribution<float> angles(direction - spread * 0.5f, direction + spread * 0.5f);
+	std::uniform_real_distribution<float> speeds(minSpeed, maxSpeed);
+	std::uniform_real_distribution<float> lifetimes(lifetime * 0.5f, lifetime);
+
+	int scaled = scaleCount(count);
+	for (int i = 0; i < scaled; i++)
+	{
+		float angle = static_cast<float>(MathUtility::DEG_TO_RAD * angles(m_random));
+		float speed = speeds(m_random);
+		sf::Vector2f velocity(std::cos(angle) * speed, std::sin(angle) * speed);
+		if (!m_particles.emit(style, position, velocity, lifetimes(m_random)))
+		{
+			break;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+int EffectSystem::scaleCount(int count) const
+{
+	int half = m_particles.getCapacity() / 2;
+	int free = m_particles.getCapacity() - m_particles.getActiveCount();
+	if (free >= half)
+	{
+		return count;
+	}
+
+	// Rounded up, so even small bursts keep at least one particle until the pool is full.
+	return (count * free + half - 1) / half;
+}
+
+////////////////////////////////////////////////////////////
+void EffectSystem::draw(sf::RenderTarget & target, sf::RenderStates states) const
+{
+	target.draw(m_particles, states);
+}
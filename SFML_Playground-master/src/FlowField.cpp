@@ -0,0 +1,192 @@
+#include "FlowField.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+////////////////////////////////////////////////////////////
+FlowField::FlowField(NavigationGrid const & grid)
+	: m_grid(grid)
+{
+}
+
+////////////////////////////////////////////////////////////
+void FlowField::reset()
+{
+	int cellCount = m_grid.getCellCount();
+	m_distance.assign(cellCount, s_UNREACHED);
+	m_queue.clear();
+	m_queue.reserve(cellCount);
+	m_queueHead = 0;
+	m_pointedCells = 0;
+	m_nextDirections.assign(cellCount, sf::Vector2f(0.0f, 0.0f));
+	m_directions.assign(cellCount, sf::Vector2f(0.0f, 0.0f));
+	m_goalCell = -1;
+	m_searchGoalCell = -1;
+	m_searching = false;
+
+	// A search expands each cell at most once and then points each cell once. Rounded up, 
+	//  so the search never takes more than s_UPDATES_PER_SEARCH updates.
+	int searchCost = cellCount * s_PASSES_PER_SEARCH;
+	m_cellsPerUpdate = std::max(s_MIN_CELLS_PER_UPDATE, (searchCost + s_UPDATES_PER_SEARCH - 1) / s_UPDATES_PER_SEARCH);
+}
+
+////////////////////////////////////////////////////////////
+void FlowField::setGoal(sf::Vector2f position)
+{
+	m_goalCell = m_grid.getCell(position);
+}
+
+////////////////////////////////////////////////////////////
+void FlowField::update()
+{
+	update(m_cellsPerUpdate);
+}
+
+////////////////////////////////////////////////////////////
+int FlowField::getCellsPerUpdate() const
+{
+	return m_cellsPerUpdate;
+}
+
+////////////////////////////////////////////////////////////
+void FlowField::update(int cellBudget)
+{
+	if (m_goalCell < 0)
+	{
+		return;
+	}
+
+	if (!m_searching)
+	{
+		if (m_goalCell == m_searchGoalCell)
+		{
+			return; // the field already leads to the goal
+		}
+		startSearch();
+	}
+
+	int columns = m_grid.getColumns();
+	int rows = m_grid.getRows();
+	static int const s_OFFSETS[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+
+	for (; cellBudget > 0 && m_queueHead < m_queue.size(); cellBudget--)
+	{
+		int cell = m_queue[m_queueHead++];
+		int column = cell % columns;
+		int row = cell / columns;
+		for (auto const & offset : s_OFFSETS)
+		{
+			int nextColumn = column + offset[0];
+			int nextRow = row + offset[1];
+			if (nextColumn < 0 || nextColumn >= columns || nextRow < 0 || nextRow >= rows ||
+				m_grid.isBlocked(nextColumn, nextRow))
+			{
+				continue;
+			}
+			int next = nextRow * columns + nextColumn;
+			if (m_distance[next] == s_UNREACHED)
+			{
+				m_distance[next] = m_distance[cell] + 1;
+				m_queue.push_back(next);
+			}
+		}
+	}
+
+	// Whatever the expansion left of the budget goes to pointing the cells.
+	if (m_queueHead == m_queue.size())
+	{
+		pointCells(cellBudget);
+	}
+}
+
+////////////////////////////////////////////////////////////
+sf::Vector2f FlowField::getDirection(sf::Vector2f position) const
+{
+	if (m_directions.empty())
+	{
+		return sf::Vector2f(0.0f, 0.0f);
+	}
+	return m_directions[m_grid.getCell(position)];
+}
+
+////////////////////////////////////////////////////////////
+void FlowField::buildNow(sf::Vector2f position)
+{
+	setGoal(position);
+	m_searching = false;
+	m_searchGoalCell = -1;
+	update(m_grid.getCellCount() * s_PASSES_PER_SEARCH);
+}
+
+////////////////////////////////////////////////////////////
+void FlowField::startSearch()
+{
+	// The goal is searched from even if a wall's clearance covers it, so the player can 
+	//  always be reached.
+	std::fill(m_distance.begin(), m_distance.end(), s_UNREACHED);
+	m_queue.clear();
+	m_queueHead = 0;
+	m_pointedCells = 0;
+	m_searchGoalCell = m_goalCell;
+	m_distance[m_searchGoalCell] = 0;
+	m_queue.push_back(m_searchGoalCell);
+	m_searching = true;
+}
+
+////////////////////////////////////////////////////////////
+void FlowField::pointCells(int cellBudget)
+{
+	int columns = m_grid.getColumns();
+	int rows = m_grid.getRows();
+	int cellCount = static_cast<int>(m_distance.size());
+	int last = std::min(cellCount, m_pointedCells + std::max(cellBudget, 0));
+
+	for (int cell = m_pointedCells; cell < last; cell++)
+	{
+		int column = cell % columns;
+		int row = cell / columns;
+
+		// Open cells point at a closer neighbour, blocked and unreached cells point at 
+		//  any reached neighbour so tanks pushed against a wall find their way out.
+		int bestDistance = m_distance[cell] == s_UNREACHED ? INT_MAX : m_distance[cell];
+		int best = -1;
+		for (int dy = -1; dy <= 1; dy++)
+		{
+			for (int dx = -1; dx <= 1; dx++)
+			{
+				int nextColumn = column + dx;
+				int nextRow = row + dy;
+				if ((dx == 0 && dy == 0) || nextColumn < 0 || nextColumn >= columns || nextRow < 0 || nextRow >= rows)
+				{
+					continue;
+				}
+				// No cutting diagonally past the corner of a blocked cell.
+				if (dx != 0 && dy != 0 && (m_grid.isBlocked(column + dx, row) || m_grid.isBlocked(column, row + dy)))
+				{
+					continue;
+				}
+				int next = nextRow * columns + nextColumn;
+				if (m_distance[next] != s_UNREACHED && m_distance[next] < bestDistance)
+				{
+					bestDistance = m_distance[next];
+					best = next;
+				}
+			}
+		}
+
+		sf::Vector2f direction(0.0f, 0.0f);
+		if (best >= 0)
+		{
+			direction = m_grid.getCellCentre(best) - m_grid.getCellCentre(cell);
+			direction /= std::sqrt(direction.x * direction.x + direction.y * direction.y);
+		}
+		m_nextDirections[cell] = direction;
+	}
+	m_pointedCells = last;
+
+	if (m_pointedCells == cellCount)
+	{
+		m_directions.swap(m_nextDirections);
+		m_searching = false;
+	}
+}
@@ -1,28 +1,51 @@
 #include "Game.h"
 #include <iostream>
 #include <ctime>
+#include <algorithm>
+#include <chrono>
 
 // Updates per milliseconds
 static double const MS_PER_UPDATE = 10.0;
 
+// The most frame time caught up on in one frame, so after a stall the game slows down
+//  for a moment instead of needing more updates each frame than it has time for.
+static double const MAX_FRAME_MS = 100.0;
+
+// The time now in microseconds, for stamping snapshots when they are published.
+static std::int64_t getMicroseconds()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 ////////////////////////////////////////////////////////////
-Game::Game()
-	: m_window(sf::VideoMode(ScreenSize::WIDTH, ScreenSize::HEIGHT, 32), "SFML Playground", sf::Style::Default)
-	, m_tank(m_texture, m_wallSprites),
-	m_aiTank(m_texture, m_wallSprites),
+Game::Game(GameSettings const& settings)
+	: m_settings(settings)
+	, m_tank(m_resources.getAtlas(), m_wallGrid),
+	m_jobs(settings.m_threads),
+	m_aiTanks(m_resources.getAtlas(), m_wallGrid, m_jobs),
 	m_hud(m_font)
 {
-	srand(time(nullptr));
+	if (m_settings.m_seed == 0)
+	{
+		m_settings.m_seed = static_cast<unsigned>(time(nullptr)); //kept so a recording can be replayed with the same numbers
+	}
+	m_random = CounterRandom(m_settings.m_seed);
+	m_tank.setRandom(m_random);
+	m_inputLog.start(m_settings.m_seed, m_settings.m_level, m_settings.m_extraWalls);
 
-	m_window.setVerticalSyncEnabled(true);
-	
-	int currentLevel = 1; //set the current level
+	Profiler::setEnabled(m_settings.m_profile);
+
+	if (!m_settings.m_headless)
+	{
+		m_window.create(sf::VideoMode(ScreenSize::WIDTH, ScreenSize::HEIGHT, 32), "SFML Playground", sf::Style::Default);
+		m_window.setVerticalSyncEnabled(true);
+	}
 	
 	//Will generate an exception if level loading fails
 
 	try
 	{
-		LevelLoader::load(currentLevel, m_level);
+		m_levels.load(m_level);
 	}
 	catch (std::exception& e)
 	{
@@ -30,93 +53,44 @@ Game::Game()
 		std::cout << e.what() << std::endl;
 		throw e;
 	}
-	//Will generate exception when texture loading fails
-	try
-	{
-		if (!m_texture.loadFromFile(".//resources//images//SpriteSheet.png"))
-		{
-			std::string s("Error loading texture");
-			throw std::exception(s.c_str());
-		}
-	}
-	catch (std::exception)
-	{
-		std::cout << "Error loading texture";
-	}
 
-	try
-	{
-		if (!m_targetTexture.loadFromFile(".//resources//images//E-100.png"))
-		{
-			std::string s("Error loading texture");
-			throw std::exception(s.c_str());
-		}
-	}
-	catch (std::exception)
+	generateExtraWalls(m_settings.m_extraWalls);
+
+	//Textures need a graphics context, which a headless game does not have, so its resource cache
+	//hands out empty ones. Sprites only use their texture rectangles for collisions, so they work without them.
+	//The sprite sheet goes first so it sits at the top left of the atlas and its texture rectangles still apply.
+	m_resources.buildAtlas({
+		".//resources//images//SpriteSheet.png",
+		".//resources//images//E-100.png",
+		".//resources//images//brick.png",
+		".//resources//images//dust.png",
+		".//resources//images//sparks.png" });
+	m_effects.setTexture(m_resources.getAtlas(),
+		m_resources.getAtlasRect(".//resources//images//sparks.png"),
+		m_resources.getAtlasRect(".//resources//images//dust.png"));
+
+	//read the best scores once, they are kept in memory from here on
+	if (!m_settings.m_headless)
 	{
-		std::cout << "Error loading texture";
+		m_scoreTable.load(".//resources//data//scores.txt"); //the old text scores are converted on the first run
 	}
 
-	try
-	{
-		if (!m_textFont.loadFromFile(".//resources//fonts//arial.ttf"))
-		{
-			std::string s("Error loading font");
-			throw std::exception(s.c_str());
-		}
-
-		if (!m_font.loadFromFile("./resources/fonts/arial.ttf"))
-		{
-			std::string s("Error loading font");
-			throw std::exception(s.c_str());
-		}
-	}
-	catch (std::exception)
-	{
-		std::cout << "Error loading font";
-	}
-
-	try
-	{
-		if (!m_bgTexture.loadFromFile(m_level.m_background.m_fileName))
-		{
-			std::string s("ERror loading texture");
-			throw std::exception(s.c_str());
-		}
-
-		m_bgSprite.setTexture(m_bgTexture);
-	}
-	catch (std::exception)
-	{
-		std::cout << "Error loading texture";
-	}
+	generateWalls(); //call the function to generate walls, and size the world
+	generateTargets(); //call the function to generate targets
 
-	//set up the scoreboard location
-	m_ScoreBoard = ".//resources//data//scores.txt";
+	m_tank.setPosition(m_level.m_tank.m_position); //set the tank position, mirrored across the world
 
-	m_tank.setPosition(m_level.m_tank.m_position); //set the tank position
-	
-	generateWalls(); //call the function to generate walls
-	generateTargets(); //call the function to generate targets
+	m_spriteBatch.setTexture(m_resources.getAtlas()); //tanks and projectiles all come from the atlas
+	m_targetBatch.setTexture(m_resources.getAtlas());
+	m_wallBatch.setTexture(m_resources.getAtlas());
 
 	m_time = 60; //set the time to 60
-	m_timerText.setFont(m_textFont); //set the timer text font
-	m_timerText.setPosition(450.0f, 0.0f); //set the timer text position
 
 	m_targetDuration = 10; //set the target duration
 
-	m_targetText.setFont(m_textFont); //set the alive timer text font 
-	m_targetText.setPosition(0.0f, 0.0f); //set the alive timer text position
-
-	m_healthText.setFont(m_textFont); //set the score text font
-	m_healthText.setPosition(700.0f, 0.0f); //set the score text position
-
 
 	m_accuracy = 100; //set accuracy to 100
 
-	m_accuracyText.setFont(m_textFont); //set the accuracy text font
-	m_accuracyText.setPosition(950.0f, 0.0f); //set the accuracy text position
-
 	alpha.a = 100; //set the alpha to 100
 
 	m_score = 0; //set the score to 0
@@ -124,48 +98,214 @@ Game::Game()
 	m_extraTime = 0; //set extra time to 0
 
 
-	m_message.setFont(m_textFont); //set the message font
+	m_message.setFont(m_font); //set the message font
 	m_message.setPosition(450.0f, 200.0f); //set the message position
 
 	m_scoreBox.setFillColor(sf::Color{ 0,0,0,100 }); //set the score box fill colour
 	m_scoreBox.setPosition(300.0f, 100.0f); //set the score box position
 	m_scoreBox.setSize(sf::Vector2f(800.0f, 600.0f)); //set the score box size
 
-	m_message1.setFont(m_textFont); //set the message 1 font
+	m_message1.setFont(m_font); //set the message 1 font
 	m_message1.setPosition(450.0f, 100.0f); //set the message 1 position
 	m_message1.setString("Press Esc to exit game"); //set the message 1 string
 
-	m_message2.setFont(m_textFont); //set the message 2 font
+	m_message2.setFont(m_font); //set the message 2 font
 	m_message2.setPosition(450.0f, 150.0f);//set the message 2 position
 	m_message2.setString("Press Space to restart the game"); //set the message 2 string
 
-	//Populate the obstacle list and set the AI tank position
-	m_aiTank.init(m_level.m_aiTank.m_position);
+	//Populate the obstacle list, bake the navigation grid and create the AI tanks
+	m_aiTanks.init(m_level.m_aiTanks, m_tank.getPosition(), m_random);
 
+	m_levels.preloadNext(); //read while this level is played, so moving on never waits on the disk
 }
 
 ////////////////////////////////////////////////////////////
 void Game::run()
 {
+	if (m_settings.m_simulationThread)
+	{
+		runThreaded();
+		saveInputLog();
+		return;
+	}
+
 	sf::Clock clock;
-	sf::Int32 lag = 0;
+	double lag = 0.0;
+
+	fillSnapshot(m_snapshots.getBack()); //something to draw before the first update
+	m_snapshots.publish();
+
+	while (m_window.isOpen())
+	{
+		{
+			ScopedTimer frameTimer(ProfileSection::FRAME); //ends before the frame's figures are stored
+
+			//measured in microseconds, so frames shorter than a millisecond still add up
+			double frameMs = clock.restart().asMicroseconds() / 1000.0;
+			lag += std::min(frameMs, MAX_FRAME_MS);
+
+			processEvents();
+			m_resources.update(); //hands over textures finished loading in the background
+
+			m_input = InputState::fromKeyboard();
+
+			bool updated = false;
+			while (lag >= MS_PER_UPDATE)
+			{
+				update(MS_PER_UPDATE);
+				lag -= MS_PER_UPDATE;
+				updated = true;
+			}
+			if (updated) //frames without an update draw the same snapshot again
+			{
+				fillSnapshot(m_snapshots.getBack());
+				m_snapshots.publish();
+			}
+
+			if (m_exitRequested)
+			{
+				m_window.close();
+			}
+
+			m_profilerOverlay.update();
+			render(m_snapshots.acquire(), static_cast<float>(lag / MS_PER_UPDATE)); //the time left over is how far into the next update this frame is
+		}
+		Profiler::endFrame();
+	}
+
+	saveInputLog();
+}
+
+////////////////////////////////////////////////////////////
+void Game::runThreaded()
+{
+	RenderSnapshot& first = m_snapshots.getBack(); //something to draw before the first update
+	fillSnapshot(first);
+	first.m_publishTime = getMicroseconds();
+	m_snapshots.publish();
+
+	m_sharedInput = InputState::fromKeyboard();
+	m_simulationRunning = true;
+	m_simulationThread = std::thread(&Game::runSimulation, this);
 
 	while (m_window.isOpen())
 	{
-		sf::Time dt = clock.restart();
+		{
+			ScopedTimer frameTimer(ProfileSection::FRAME); //ends before the frame's figures are stored
+
+			processEvents();
+			m_resources.update(); //hands over textures finished loading in the background
+
+			InputState input = InputState::fromKeyboard();
+			{
+				std::lock_guard<std::mutex> lock(m_inputMutex);
+				m_sharedInput = input;
+			}
+
+			if (m_exitRequested)
+			{
+				m_window.close();
+			}
+
+			RenderSnapshot const& snapshot = m_snapshots.acquire();
+			double sincePublished = (getMicroseconds() - snapshot.m_publishTime) / 1000.0;
+			float alpha = static_cast<float>(std::clamp(sincePublished / MS_PER_UPDATE, 0.0, 1.0));
+
+			m_profilerOverlay.update();
+			render(snapshot, alpha);
+		}
+		Profiler::endFrame();
+	}
 
-		lag += dt.asMilliseconds();
+	m_simulationRunning = false;
+	m_simulationThread.join();
+}
 
-		processEvents();
+////////////////////////////////////////////////////////////
+void Game::runSimulation()
+{
+	auto const step = std::chrono::microseconds(static_cast<std::int64_t>(MS_PER_UPDATE * 1000));
+	auto const maxLag = std::chrono::microseconds(static_cast<std::int64_t>(MAX_FRAME_MS * 1000));
+	auto next = std::chrono::steady_clock::now();
 
-		while (lag > MS_PER_UPDATE)
+	while (m_simulationRunning)
+	{
 		{
-			update(MS_PER_UPDATE);
-			lag -= MS_PER_UPDATE;
+			std::lock_guard<std::mutex> lock(m_inputMutex);
+			m_input = m_sharedInput;
 		}
+
 		update(MS_PER_UPDATE);
 
-		render();
+		RenderSnapshot& snapshot = m_snapshots.getBack();
+		fillSnapshot(snapshot);
+		snapshot.m_publishTime = getMicroseconds();
+		m_snapshots.publish();
+
+		next += step;
+		auto now = std::chrono::steady_clock::now();
+		if (now - next > maxLag)
+		{
+			next = now; //too far behind to catch up, so drop the lost time
+		}
+		std::this_thread::sleep_until(next);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void Game::step(InputState const& input)
+{
+	m_input = input;
+	update(MS_PER_UPDATE);
+	Profiler::endFrame();
+}
+
+////////////////////////////////////////////////////////////
+double Game::getUpdateStep()
+{
+	return MS_PER_UPDATE;
+}
+
+////////////////////////////////////////////////////////////
+int Game::getWallCount() const
+{
+	return m_wallSprites.size();
+}
+
+////////////////////////////////////////////////////////////
+std::uint64_t Game::getStateHash() const
+{
+	StateHash hash;
+	hash.add(m_tick);
+	hash.add(m_gameState);
+	hash.add(m_levels.getCurrent());
+	hash.add(m_time);
+	hash.add(m_score);
+	hash.add(m_accuracy);
+	hash.add(targetsCollected);
+	hash.add(targetsAlive);
+	m_tank.hashState(hash);
+	m_aiTanks.hashState(hash);
+	return hash.getValue();
+}
+
+////////////////////////////////////////////////////////////
+void Game::saveInputLog()
+{
+	if (m_settings.m_recordFile.empty())
+	{
+		return;
+	}
+
+	m_inputLog.finish(getStateHash());
+	try
+	{
+		m_inputLog.save(m_settings.m_recordFile);
+		std::cout << "Input recorded to " << m_settings.m_recordFile << std::endl;
+	}
+	catch (std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
 	}
 }
 
@@ -196,6 +336,14 @@ void Game::processGameEvents(sf::Event& event)
 		case sf::Keyboard::Escape:
 			m_window.close();
 			break;
+		case sf::Keyboard::F3: //toggle the profiler and its overlay
+			Profiler::setEnabled(!Profiler::isEnabled());
+			break;
+		case sf::Keyboard::F4: //dump the recent profile for offline analysis
+			Profiler::writeCsv("./profile.csv");
+			Profiler::writeChromeTrace("./profile.json");
+			std::cout << "Profile written to profile.csv and profile.json" << std::endl;
+			break;
 		default:
 			break;
 		}
@@ -206,76 +354,179 @@ void Game::generateWalls()
 {
 
 	sf::IntRect wallRect(2, 129, 33, 23);
-	//Create the Walls
+	//Create the Walls, reusing the storage of the last level's
+	m_wallSprites.clear();
 	for (ObstacleData const& obstacle : m_level.m_obstacles)
 	{
 		sf::Sprite sprite;
-		sprite.setTexture(m_texture);
+		sprite.setTexture(m_resources.getAtlas());
 		sprite.setTextureRect(wallRect);
 		sprite.setOrigin(wallRect.width / 2.0, wallRect.height / 2.0);
 		sprite.setPosition(obstacle.m_position);
 		sprite.setRotation(obstacle.m_rotation);
 		m_wallSprites.push_back(sprite);
 	}
+
+	m_wallGrid.setWorldSize(m_level.m_world.m_size);
+	m_wallGrid.build();
+	m_camera.setWorldSize(m_level.m_world.m_size);
+
+	//render may still be drawing the last level's walls, so they are replaced rather than changed
+	m_publishedWalls = std::make_shared<std::vector<sf::Sprite> const>(m_wallSprites);
+	m_wallVersion++; //render rebuilds its wall chunks and repaints the static layer
 }
 
 void Game::generateTargets()
 {
-	//Create the targets
+	//Create the targets, reusing the storage of the last level's
+	m_targets.clear();
+	m_targetBoxes.clear();
 	for (TargetData const& target : m_level.m_targets)
 	{
 		int offset = target.m_randomOffset;
 
-		int randomOffset = rand() % (offset*2) + (-50);
+		int randomOffset = m_random.getInt(offset * 2, RandomStream::TARGETS, m_tick, static_cast<std::uint32_t>(m_targets.size())) + (-50);
 
 
 		sf::Sprite sprite;
-		sprite.setTexture(m_targetTexture);
+		sprite.setTexture(m_resources.getAtlas());
+		sprite.setTextureRect(m_resources.getAtlasRect(".//resources//images//E-100.png"));
 		sprite.setScale(0.5f, 0.5f);
 		sprite.setPosition(target.m_position.x + randomOffset, target.m_position.y + randomOffset);
 		sprite.setRotation(target.m_rotation);
 		m_targets.push_back(sprite);
+		m_targetBoxes.push_back(OrientedBoundingBox(sprite));
 	}
 }
 
 void Game::saveScores()
 {
-	std::ofstream outputFile; //create an output file stream
-	outputFile.open(m_ScoreBoard, outputFile.app); //open the output file from the scoreboard string location and append the output
-	if (outputFile.is_open()) //check if the file was opened
+	if (!m_scoreSaved) //the time stays at 0, so only the first call adds the score
+	{
+		m_scoreTable.add(m_score, m_accuracy); //the file is appended to on the score table's writer thread
+		m_scoreSaved = true;
+	}
+}
+
+void Game::getScores(RenderSnapshot const& snapshot)
+{
+	if (m_scoreVersion != snapshot.m_scoreVersion) //only rebuild the text when the table has changed
 	{
-		outputFile << "Score: " << std::to_string(m_score)<<"  Accuracy: " << std::to_string(m_accuracy); //Add core and accuracy to the file
-		outputFile << std::endl; //make a new line
+		m_scoreVersion = snapshot.m_scoreVersion;
+		m_message.setString(snapshot.m_scores); //set the message string
+	}
+}
 
-		outputFile.close(); //close the file
+void Game::generateExtraWalls(int count)
+{
+	//Scatter walls over the whole world, away from the edges
+	int width = static_cast<int>(m_level.m_world.m_size.x);
+	int height = static_cast<int>(m_level.m_world.m_size.y);
+	for (int i = 0; i < count; i++)
+	{
+		ObstacleData obstacle;
+		obstacle.m_type = "wall";
+		std::uint32_t index = static_cast<std::uint32_t>(i) * 3; //three numbers per wall
+		obstacle.m_position.x = 50 + m_random.getInt(width - 100, RandomStream::EXTRA_WALLS, m_tick, index);
+		obstacle.m_position.y = 50 + m_random.getInt(height - 100, RandomStream::EXTRA_WALLS, m_tick, index + 1);
+		obstacle.m_rotation = m_random.getInt(360, RandomStream::EXTRA_WALLS, m_tick, index + 2);
+		m_level.m_obstacles.push_back(obstacle);
 	}
 }
 
-void Game::getScores()
+void Game::nextLevel()
 {
-	m_scores.clear(); //clear the score string
-	std::ifstream inputFile; //create and input file 
-	inputFile.open(m_ScoreBoard); //open the input file from the scoreboard string location
+	//The load started with this level and has normally long finished. Waiting for it anyway means the
+	//level played next never depends on the speed of the disk, so a replayed game follows the recorded one.
+	m_levels.waitForNext();
+	if (m_levels.swapInNext(m_level)) //if the next level failed to load, this one is played again
+	{
+		generateExtraWalls(m_settings.m_extraWalls);
+		generateWalls();
+		generateTargets();
+	}
+	restartGame();
+	m_levels.preloadNext();
+}
 
-	if (inputFile.is_open()) //check if file is open
+////////////////////////////////////////////////////////////
+void Game::applyCollisionEvents()
+{
+	for (CollisionEvent const& event : m_collisionEvents)
 	{
-		while (!inputFile.eof()) //while the file is open
+		if (event.m_victim == CollisionEvent::PLAYER)
+		{
+			m_tank.takeDamage();
+		}
+		else if (event.m_victim >= 0)
 		{
-			std::getline(inputFile, scores); //get the line and append it to scores
-			m_scores += scores + "\n"; //add the scores and a new line to the text 
+			m_aiTanks.takeDamage(event.m_victim);
 		}
 	}
-	m_message.setString(m_scores); //set the message string
 }
 
+////////////////////////////////////////////////////////////
+void Game::publishEffects()
+{
+	std::lock_guard<std::mutex> lock(m_effectMutex);
+
+	auto publish = [this](EffectEvent const& effect)
+	{
+		if (m_publishedEffects.size() < s_MAX_PUBLISHED_EFFECTS)
+		{
+			m_publishedEffects.push_back(effect);
+		}
+	};
+
+	for (EffectEvent const& effect : m_tank.getEffects())
+	{
+		publish(effect);
+	}
+
+	m_aiTanks.collectEffects(m_publishedEffects);
+	if (m_publishedEffects.size() > s_MAX_PUBLISHED_EFFECTS)
+	{
+		m_publishedEffects.resize(s_MAX_PUBLISHED_EFFECTS);
+	}
+
+	for (CollisionEvent const& event : m_collisionEvents)
+	{
+		EffectType type = event.m_wall != CollisionEvent::NONE ? EffectType::WALL_IMPACT : EffectType::TANK_IMPACT;
+		publish(EffectEvent{ type, event.m_point, 0.0f });
+	}
+}
+
+////////////////////////////////////////////////////////////
+void Game::playEffects(sf::FloatRect const& area)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_effectMutex);
+		m_playedEffects.swap(m_publishedEffects);
+	}
+
+	sf::FloatRect nearby(area.left - s_CULL_MARGIN, area.top - s_CULL_MARGIN, area.width + s_CULL_MARGIN * 2.0f, area.height + s_CULL_MARGIN * 2.0f);
+	for (EffectEvent const& effect : m_playedEffects)
+	{
+		if (nearby.contains(effect.m_position)) //effects out of view would spend the particle budget on nothing
+		{
+			m_effects.emit(effect);
+		}
+	}
+	m_playedEffects.clear();
+
+	m_effects.update(std::min(m_effectClock.restart().asSeconds(), s_MAX_EFFECT_STEP));
+}
+
+////////////////////////////////////////////////////////////
 void Game::restartGame()
 {
 	m_time = 60; //set the time to 60
 	m_accuracy = 100; //set accuracy to 100
 	targetsCollected = 0; //set the score to 0
+	m_scoreSaved = false; //the next game gets its own score
 	m_tank.setPosition(m_level.m_tank.m_position); //set the tank position
 	m_tank.setHealth();
-	m_aiTank.init(m_level.m_aiTank.m_position);
+	m_aiTanks.init(m_level.m_aiTanks, m_tank.getPosition(), m_random); //the same seed in every round
 
 	for (int i = 0; i < m_targets.size(); i++) //loop for all the targets
 	{
@@ -289,11 +540,24 @@ void Game::restartGame()
 ////////////////////////////////////////////////////////////
 void Game::update(double dt)
 {
+	ScopedTimer updateTimer(ProfileSection::UPDATE);
+
+	m_simulationTime += sf::microseconds(static_cast<sf::Int64>(dt * 1000));
+	m_tick++;
+	m_collisionEvents.clear();
+
+	if (!m_settings.m_recordFile.empty())
+	{
+		m_inputLog.record(m_input);
+	}
 
 	if (m_gameState==GameState::GAME_RUNNING) //if the game is not over
 	{
 		
-		m_aiTank.update(m_tank, dt);
+		{
+			ScopedTimer timer(ProfileSection::AI_UPDATE);
+			m_aiTanks.update(m_tank, dt, m_tick);
+		}
 
 		if (m_time >= 1) //if time is more than or equal to 1
 		{
@@ -304,12 +568,10 @@ void Game::update(double dt)
 			}
 		}
 
-		m_targetText.setString("Targets: " + std::to_string(targetsCollected) + " out of " + std::to_string(MAX_TARGETS)); //set the alive timer text string
-		m_timerText.setString("Time Left: " + std::to_string(m_time)); //set the timer text string
-		m_healthText.setString("Health: " + std::to_string(m_tank.getHealth())); //set the score text string
-		m_accuracyText.setString("Accuracy: " + std::to_string(static_cast<int>(m_accuracy)) + "%"); //set the accuracy text string
-
-		m_tank.update(dt, targetsAlive, m_score, m_accuracy, m_aiTank); //call the tank update function
+		{
+			ScopedTimer timer(ProfileSection::PLAYER_UPDATE);
+			m_tank.update(dt, m_input, targetsAlive, m_score, m_accuracy, m_aiTanks, m_tick, m_collisionEvents); //call the tank update function
+		}
 
 		for (int i = 0; i < m_targets.size(); i++) //loop for all the targets
 		{
@@ -319,33 +581,40 @@ void Game::update(double dt)
 			}
 		}
 
-		if (m_time == 0) //if time is equal to 0
+		if (m_time == 0 && !m_settings.m_headless) //if time is equal to 0
 		{
 			saveScores(); //call the save score function
 		}
 
-		if (m_aiTank.collidesWithPlayer(m_tank))
 		{
-			m_tank.takeDamage();
+			ScopedTimer timer(ProfileSection::COLLISION);
+			m_aiTanks.applyDamage(m_tank); //collisions with every AI tank
+			m_aiTanks.collectEvents(m_collisionEvents); //after the player's own hits, in tank order
+			applyCollisionEvents();
 		}
-		if (m_aiTank.m_hitTarget)
+		if (!m_settings.m_headless)
 		{
-			m_aiTank.m_hitTarget = false;
-			m_tank.takeDamage();
+			publishEffects(); //nothing plays the effects of a headless game
 		}
 		if (m_tank.getHealth() <= 0)
 		{
 			m_gameState = GameState::GAME_LOSE;
 		}
-		for (int i = 0; i < m_targets.size(); i++)
 		{
-			if (targetsAlive[i])
+			ScopedTimer timer(ProfileSection::COLLISION);
+			TankColliders tankColliders = m_tank.getColliders();
+			OrientedBoundingBox turretBox = tankColliders.m_turret.getBox(); //the tank bounding boxes, built once for all targets
+			OrientedBoundingBox baseBox = tankColliders.m_base.getBox();
+			for (int i = 0; i < m_targets.size(); i++)
 			{
-				if (CollisionDetector::collision(m_tank.getTurret(), m_targets[i]) ||
-					CollisionDetector::collision(m_tank.getBase(), m_targets[i]))
+				if (targetsAlive[i])
 				{
-					targetsAlive[i] = false;
-					targetsCollected++;
+					if (CollisionDetector::collision(turretBox, m_targetBoxes[i]) ||
+						CollisionDetector::collision(baseBox, m_targetBoxes[i]))
+					{
+						targetsAlive[i] = false;
+						targetsCollected++;
+					}
 				}
 			}
 		}
@@ -356,15 +625,13 @@ void Game::update(double dt)
 	}
 	else if(m_gameState==GameState::GAME_WIN)//other wise
 	{
-		getScores(); //call the get scores function
-
-		if (sf::Keyboard::isKeyPressed(sf::Keyboard::Escape)) //if escape is pressed
+		if (m_input.m_exit) //if escape is pressed
 		{
-			m_window.close(); //close the window / game
+			m_exitRequested = true; //the window / game is closed by the main thread
 		}
-		if (sf::Keyboard::isKeyPressed(sf::Keyboard::Return)) //if space is pressed 
+		if (m_input.m_restart) //if space is pressed 
 		{
-			restartGame(); //restart the game
+			nextLevel(); //move on to the next level in the rotation
 			m_gameState = GameState::GAME_RUNNING;
 		}
 	}
@@ -377,60 +644,202 @@ void Game::update(double dt)
 			m_restartTimer.restart();
 		}
 	}
+}
+
+////////////////////////////////////////////////////////////
+void Game::fillSnapshot(RenderSnapshot& snapshot)
+{
+	snapshot.m_gameState = m_gameState;
+	snapshot.m_hud = HudValues{ targetsCollected, MAX_TARGETS, m_time, m_tank.getHealth(), static_cast<int>(m_accuracy), m_gameState };
+
+	snapshot.m_walls = m_publishedWalls;
+	snapshot.m_worldSize = m_level.m_world.m_size;
+	snapshot.m_wallVersion = m_wallVersion;
+	snapshot.m_background = m_level.m_background.m_fileName;
+	if (m_levels.isNextReady())
+	{
+		snapshot.m_nextBackground = m_levels.getNext().m_background.m_fileName;
+	}
+	else
+	{
+		snapshot.m_nextBackground.clear();
+	}
+
+	snapshot.m_sprites.clear();
+	snapshot.m_targets.clear();
+	snapshot.m_vision.clear();
+	snapshot.m_visionSizes.clear();
+
+	snapshot.m_cameraCentre = m_camera.getCentre(m_tank.getPosition());
+	snapshot.m_lastCameraCentre = m_camera.getCentre(m_tank.getLastPosition());
+
+	if (m_gameState == GameState::GAME_RUNNING)
+	{
+		sf::FloatRect area = m_camera.getArea(snapshot.m_cameraCentre);
+		area.left -= s_CULL_MARGIN;
+		area.top -= s_CULL_MARGIN;
+		area.width += s_CULL_MARGIN * 2.0f;
+		area.height += s_CULL_MARGIN * 2.0f;
+
+		m_tank.render(snapshot.m_sprites); //the camera follows the player, so it is always in view
+		m_aiTanks.render(snapshot.m_sprites, area);
+		m_aiTanks.renderVision(snapshot.m_vision, snapshot.m_visionSizes, area);
+
+		for (int i = 0; i < m_targets.size(); i++) //loop for all the targets
+		{
+			//if the target is alive, the time is less than the target spawn time and it is near the camera
+			if (m_time <= m_level.m_targets[i].m_spawnTime && targetsAlive[i] && area.intersects(m_targetBoxes[i].Bounds))
+			{
+				snapshot.m_targets.push_back(SpriteInstance(m_targets[i], SpriteSnapshot(m_targets[i])));
+			}
+		}
+	}
+	else if (m_gameState == GameState::GAME_WIN && snapshot.m_scoreVersion != m_scoreTable.getVersion())
+	{
+		snapshot.m_scores = m_scoreTable.getText(); //only copied when the table has changed
+		snapshot.m_scoreVersion = m_scoreTable.getVersion();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void Game::loadBackgrounds(RenderSnapshot const& snapshot)
+{
+	if (snapshot.m_background != m_shownBackground)
+	{
+		//the old background stays up until the new one has loaded
+		m_shownBackground = snapshot.m_background;
+		std::string background = m_shownBackground;
+		m_resources.loadAsync({ background }, [this, background]()
+		{
+			if (background == m_shownBackground) //another level may have started while this loaded
+			{
+				sf::Texture& texture = m_resources.getTexture(background);
+				texture.setRepeated(true); //tiled across worlds larger than the image
+				m_bgSprite.setTexture(texture);
+				m_staticLayer.invalidate(); //painted again with the new background
+			}
+		});
+	}
 
-	m_hud.update(m_gameState);
+	if (!snapshot.m_nextBackground.empty() && snapshot.m_nextBackground != m_prefetchedBackground)
+	{
+		//loaded before the next level starts, so it shows on its first frame
+		m_prefetchedBackground = snapshot.m_nextBackground;
+		m_resources.loadAsync({ m_prefetchedBackground }, nullptr);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void Game::rebuildStaticLayer(RenderSnapshot const& snapshot)
+{
+	if (snapshot.m_wallVersion == m_paintedWallVersion || !snapshot.m_walls)
+	{
+		return;
+	}
+
+	m_paintedWallVersion = snapshot.m_wallVersion;
+	m_wallBatch.build(*snapshot.m_walls, snapshot.m_worldSize);
+	m_staticLayer.invalidate();
 }
 
 ////////////////////////////////////////////////////////////
-void Game::render()
+void Game::render(RenderSnapshot const& snapshot, float alpha)
 {
-	if (m_gameState == GameState::GAME_RUNNING) //if its not game over
+	ScopedTimer renderTimer(ProfileSection::RENDER);
+
+	loadBackgrounds(snapshot);
+
+	if (snapshot.m_gameState == GameState::GAME_RUNNING) //if its not game over
 	{
 		m_window.clear(sf::Color(0, 0, 0, 0)); //clear the screen 
 
-		m_window.draw(m_bgSprite); //draw the background sprite
-		m_tank.render(m_window); //call the tank draw function
-		m_aiTank.render(m_window);
+		//the camera is blended between updates like the tanks, so it moves as smoothly as the player
+		sf::Vector2f centre = snapshot.m_lastCameraCentre + (snapshot.m_cameraCentre - snapshot.m_lastCameraCentre) * alpha;
+		sf::FloatRect viewArea = m_camera.getArea(centre);
+		m_view = m_camera.getView(centre);
+		m_window.setView(m_view);
 
-		for (auto const& obstacle : m_wallSprites) //auto for loop for all the obstacles
 		{
-			m_window.draw(obstacle); //draw the obstacles
+			ScopedTimer timer(ProfileSection::RENDER_STATIC_LAYER);
+			rebuildStaticLayer(snapshot);
+			//only tiles coming into view for the first time are painted, the rest are drawn from the cache
+			m_staticLayer.render(m_window, viewArea, [this](sf::RenderTarget& target, sf::FloatRect const& area)
+			{
+				//the background texture repeats, so the tile's part of it is its own area of the world
+				m_bgSprite.setTextureRect(sf::IntRect(area));
+				m_bgSprite.setPosition(area.left, area.top);
+				target.draw(m_bgSprite); //draw the background sprite
+				m_wallBatch.render(target, area); //draw the obstacles over it
+			});
 		}
-		
-		for (int i = 0; i < m_targets.size(); i++) //loop for all the targets
+
 		{
-			//if the target is alive and the time is less than the target spawn time
-			if (m_time <= m_level.m_targets[i].m_spawnTime && targetsAlive[i]) 
+			ScopedTimer timer(ProfileSection::RENDER_SPRITES);
+			m_spriteBatch.clear();
+			for (SpriteInstance const& sprite : snapshot.m_sprites)
 			{
-				m_window.draw(m_targets[i]); //draw the targets
+				m_spriteBatch.add(sprite, alpha);
 			}
-		}
+			draw(m_spriteBatch); //draw all tanks and projectiles
 
-		m_window.draw(m_timerText); //draw the timer text
-		m_window.draw(m_targetText); //draw the alive timer text
+			int first = 0;
+			for (int size : snapshot.m_visionSizes) //draw the AI vision cones
+			{
+				m_window.draw(&snapshot.m_vision[first], size, sf::TriangleFan);
+				Profiler::count(ProfileCounter::DRAW_CALLS);
+				first += size;
+			}
+		}
 
-		m_window.draw(m_healthText); //draw the score text
+		{
+			ScopedTimer timer(ProfileSection::RENDER_TARGETS);
+			m_targetBatch.clear();
+			for (SpriteInstance const& target : snapshot.m_targets) //loop for the targets on screen
+			{
+				m_targetBatch.add(target, alpha); //add the target to the batch
+			}
+			draw(m_targetBatch); //draw the targets
+		}
 
-		m_window.draw(m_accuracyText); //draw the accuracy text
+		{
+			ScopedTimer timer(ProfileSection::RENDER_EFFECTS);
+			playEffects(viewArea);
+			draw(m_effects); //every particle in one draw call, over the tanks and walls
+		}
 
+		m_window.setView(m_window.getDefaultView()); //the HUD stays put while the world scrolls
 	}
-	else if(m_gameState==GameState::GAME_WIN)//otherwise
+	else if(snapshot.m_gameState==GameState::GAME_WIN)//otherwise
 	{
-		m_window.draw(m_scoreBox); //draw the score box
-		m_window.draw(m_message); //draw the message
-		m_window.draw(m_message1); //draw the message 1
-		m_window.draw(m_message2); //draw the message 2
+		ScopedTimer timer(ProfileSection::RENDER_TEXT);
+		getScores(snapshot); //call the get scores function
+		draw(m_scoreBox); //draw the score box
+		draw(m_message); //draw the message
+		draw(m_message1); //draw the message 1
+		draw(m_message2); //draw the message 2
 	}
-	else if (m_gameState == GameState::GAME_LOSE)//otherwise
+	else if (snapshot.m_gameState == GameState::GAME_LOSE)//otherwise
 	{
 
 	}
 
-	m_hud.render(m_window);
+	{
+		ScopedTimer timer(ProfileSection::RENDER_TEXT);
+		m_hud.update(snapshot.m_hud); //the HUD only lays its text out again when a value has changed
+		m_hud.render(m_window); //the targets, time, health and accuracy are drawn by the HUD
+	}
+	m_profilerOverlay.render(m_window); //only drawn while profiling
 
 	m_window.display(); //display the window
 }
 
+////////////////////////////////////////////////////////////
+void Game::draw(sf::Drawable const& drawable)
+{
+	m_window.draw(drawable);
+	Profiler::count(ProfileCounter::DRAW_CALLS);
+}
+
 
 
 
@@ -1,16 +1,12 @@
 #include "HUD.h"
+#include "Profiler.h"
+#include <string>
 
 ////////////////////////////////////////////////////////////
 HUD::HUD(sf::Font& hudFont)
-	: m_textFont(hudFont)
+	: m_text(hudFont, 30)
 {
-	m_gameStateText.setFont(hudFont);
-	m_gameStateText.setCharacterSize(30);
-	m_gameStateText.setFillColor(sf::Color::Blue);
-	m_gameStateText.setPosition(sf::Vector2f(480, 5));
-	m_gameStateText.setString("Game Running");
-
-	//Setting up our hud properties 
+	//Setting up our hud properties
 	m_hudOutline.setSize(sf::Vector2f(1440.0f, 40.0f));
 	m_hudOutline.setFillColor(sf::Color(0, 0, 0, 38));
 	m_hudOutline.setOutlineThickness(-.5f);
@@ -19,26 +15,57 @@ HUD::HUD(sf::Font& hudFont)
 }
 
 ////////////////////////////////////////////////////////////
-void HUD::update(GameState const& gameState)
+void HUD::update(HudValues const& values)
+{
+	if (values.m_targetsCollected != m_values.m_targetsCollected ||
+		values.m_maxTargets != m_values.m_maxTargets ||
+		values.m_time != m_values.m_time ||
+		values.m_health != m_values.m_health ||
+		values.m_accuracy != m_values.m_accuracy ||
+		values.m_gameState != m_values.m_gameState)
+	{
+		m_values = values;
+		m_dirty = true;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void HUD::layout()
 {
-	switch (gameState)
+	m_text.clear();
+
+	switch (m_values.m_gameState)
 	{
 	case GameState::GAME_RUNNING:
-		m_gameStateText.setString("Game Running");
+		m_text.add("Targets: " + std::to_string(m_values.m_targetsCollected) + " out of " + std::to_string(m_values.m_maxTargets),
+			sf::Vector2f(0.0f, 0.0f), sf::Color::White);
+		m_text.add("Time Left: " + std::to_string(m_values.m_time), sf::Vector2f(450.0f, 0.0f), sf::Color::White);
+		m_text.add("Health: " + std::to_string(m_values.m_health), sf::Vector2f(700.0f, 0.0f), sf::Color::White);
+		m_text.add("Accuracy: " + std::to_string(m_values.m_accuracy) + "%", sf::Vector2f(950.0f, 0.0f), sf::Color::White);
+		m_text.add("Game Running", sf::Vector2f(480.0f, 5.0f), sf::Color::Blue);
 		break;
 	case GameState::GAME_LOSE:
-		m_gameStateText.setString("You Lost");
+		m_text.add("You Lost", sf::Vector2f(480.0f, 5.0f), sf::Color::Blue);
 		break;
 	case GameState::GAME_WIN:
-		m_gameStateText.setString("You Won");
+		m_text.add("You Won", sf::Vector2f(480.0f, 5.0f), sf::Color::Blue);
 		break;
 	default:
 		break;
 	}
+
+	m_dirty = false;
 }
 
+////////////////////////////////////////////////////////////
 void HUD::render(sf::RenderWindow& window)
 {
+	if (m_dirty)
+	{
+		layout();
+	}
+
 	window.draw(m_hudOutline);
-	window.draw(m_gameStateText);
-}
\ No newline at end of file
+	window.draw(m_text);
+	Profiler::count(ProfileCounter::DRAW_CALLS, 2);
+}
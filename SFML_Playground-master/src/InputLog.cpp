@@ -0,0 +1,121 @@
+#include "InputLog.h"
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+static char const s_MAGIC[4] = { 'T', 'I', 'N', 'P' };
+
+////////////////////////////////////////////////////////////
+void InputLog::start(std::uint32_t seed, int level, int extraWalls)
+{
+	m_header = InputLogHeader{};
+	std::memcpy(m_header.m_magic, s_MAGIC, sizeof(s_MAGIC));
+	m_header.m_version = s_VERSION;
+	m_header.m_seed = seed;
+	m_header.m_level = level;
+	m_header.m_extraWalls = extraWalls;
+	m_runs.clear();
+}
+
+////////////////////////////////////////////////////////////
+void InputLog::record(InputState const & input)
+{
+	std::uint16_t controls = pack(input);
+	if (m_runs.empty() || m_runs.back().m_controls != controls ||
+		m_runs.back().m_ticks == std::numeric_limits<std::uint16_t>::max())
+	{
+		m_runs.push_back(InputRun{ controls, 0 });
+	}
+	m_runs.back().m_ticks++;
+	m_header.m_tickCount++;
+}
+
+////////////////////////////////////////////////////////////
+void InputLog::finish(std::uint64_t stateHash)
+{
+	m_header.m_stateHash = stateHash;
+}
+
+////////////////////////////////////////////////////////////
+void InputLog::save(std::string const & fileName) const
+{
+	std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+	file.write(reinterpret_cast<char const *>(&m_header), sizeof(m_header));
+	file.write(reinterpret_cast<char const *>(m_runs.data()), m_runs.size() * sizeof(InputRun));
+	if (!file)
+	{
+		std::string message("File: " + fileName + " could not be written");
+		throw std::exception(message.c_str());
+	}
+}
+
+////////////////////////////////////////////////////////////
+void InputLog::load(std::string const & fileName)
+{
+	std::ifstream file(fileName, std::ios::binary);
+	InputLogHeader header;
+	if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+		std::memcmp(header.m_magic, s_MAGIC, sizeof(s_MAGIC)) != 0 ||
+		header.m_version != s_VERSION)
+	{
+		std::string message("File: " + fileName + " is not an input log of version " + std::to_string(s_VERSION));
+		throw std::exception(message.c_str());
+	}
+
+	//Runs are read until the ticks they cover add up to the header's count, so a log
+	//cut short is reported instead of replayed as a different game
+	std::vector<InputRun> runs;
+	std::uint32_t tickCount = 0;
+	InputRun run;
+	while (tickCount < header.m_tickCount && file.read(reinterpret_cast<char *>(&run), sizeof(run)))
+	{
+		runs.push_back(run);
+		tickCount += run.m_ticks;
+	}
+	if (tickCount != header.m_tickCount)
+	{
+		std::string message("File: " + fileName + " does not hold the " + std::to_string(header.m_tickCount) + " updates it was recorded with");
+		throw std::exception(message.c_str());
+	}
+
+	m_header = header;
+	m_runs.swap(runs);
+}
+
+////////////////////////////////////////////////////////////
+InputLogHeader const & InputLog::getHeader() const
+{
+	return m_header;
+}
+
+////////////////////////////////////////////////////////////
+std::vector<InputRun> const & InputLog::getRuns() const
+{
+	return m_runs;
+}
+
+////////////////////////////////////////////////////////////
+std::uint16_t InputLog::pack(InputState const & input)
+{
+	return static_cast<std::uint16_t>(
+		(input.m_left << 0) | (input.m_right << 1) | (input.m_up << 2) | (input.m_down << 3) |
+		(input.m_turretLeft << 4) | (input.m_turretRight << 5) | (input.m_centreTurret << 6) |
+		(input.m_fire << 7) | (input.m_restart << 8) | (input.m_exit << 9));
+}
+
+////////////////////////////////////////////////////////////
+InputState InputLog::unpack(std::uint16_t controls)
+{
+	InputState input;
+	input.m_left = (controls & (1 << 0)) != 0;
+	input.m_right = (controls & (1 << 1)) != 0;
+	input.m_up = (controls & (1 << 2)) != 0;
+	input.m_down = (controls & (1 << 3)) != 0;
+	input.m_turretLeft = (controls & (1 << 4)) != 0;
+	input.m_turretRight = (controls & (1 << 5)) != 0;
+	input.m_centreTurret = (controls & (1 << 6)) != 0;
+	input.m_fire = (controls & (1 << 7)) != 0;
+	input.m_restart = (controls & (1 << 8)) != 0;
+	input.m_exit = (controls & (1 << 9)) != 0;
+	return input;
+}
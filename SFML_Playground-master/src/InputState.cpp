@@ -0,0 +1,19 @@
+#include "InputState.h"
+#include <SFML/Window/Keyboard.hpp>
+
+////////////////////////////////////////////////////////////
+InputState InputState::fromKeyboard()
+{
+	InputState input;
+	input.m_left = sf::Keyboard::isKeyPressed(sf::Keyboard::Left);
+	input.m_right = sf::Keyboard::isKeyPressed(sf::Keyboard::Right);
+	input.m_up = sf::Keyboard::isKeyPressed(sf::Keyboard::Up);
+	input.m_down = sf::Keyboard::isKeyPressed(sf::Keyboard::Down);
+	input.m_turretLeft = sf::Keyboard::isKeyPressed(sf::Keyboard::Z);
+	input.m_turretRight = sf::Keyboard::isKeyPressed(sf::Keyboard::X);
+	input.m_centreTurret = sf::Keyboard::isKeyPressed(sf::Keyboard::C);
+	input.m_fire = sf::Keyboard::isKeyPressed(sf::Keyboard::Space);
+	input.m_restart = sf::Keyboard::isKeyPressed(sf::Keyboard::Return);
+	input.m_exit = sf::Keyboard::isKeyPressed(sf::Keyboard::Escape);
+	return input;
+}
@@ -0,0 +1,151 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+////////////////////////////////////////////////////////////
+JobSystem::JobSystem(int threadCount)
+{
+	if (threadCount <= 0)
+	{
+		threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	}
+
+	for (int i = 0; i < threadCount; i++)
+	{
+		m_queues.push_back(std::make_unique<Queue>());
+	}
+
+	// The calling thread runs queue 0, so only the other queues need a worker.
+	for (int i = 1; i < threadCount; i++)
+	{
+		m_workers.emplace_back(&JobSystem::workerLoop, this, i);
+	}
+}
+
+////////////////////////////////////////////////////////////
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+		m_stop = true;
+	}
+	m_wake.notify_all();
+
+	for (std::thread & worker : m_workers)
+	{
+		worker.join();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void JobSystem::parallelFor(int count, int chunkSize, std::function<void(int, int)> const & job)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+	chunkSize = std::max(1, chunkSize);
+
+	// Not worth waking anyone for a single chunk.
+	if (m_workers.empty() || count <= chunkSize)
+	{
+		job(0, count);
+		return;
+	}
+
+	int chunkCount = (count + chunkSize - 1) / chunkSize;
+	m_remaining.store(chunkCount);
+
+	int queueCount = static_cast<int>(m_queues.size());
+	for (int chunk = 0; chunk < chunkCount; chunk++)
+	{
+		int begin = chunk * chunkSize;
+		Queue & queue = *m_queues[chunk % queueCount];
+		std::lock_guard<std::mutex> lock(queue.m_mutex);
+		queue.m_chunks.push_back(Chunk{ &job, begin, std::min(count, begin + chunkSize) });
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+		m_generation++;
+	}
+	m_wake.notify_all();
+
+	// Help out until the queues are empty, then wait for chunks still running elsewhere.
+	while (runOne(0))
+	{
+	}
+	while (m_remaining.load() > 0)
+	{
+		std::this_thread::yield();
+	}
+}
+
+////////////////////////////////////////////////////////////
+int JobSystem::getThreadCount() const
+{
+	return static_cast<int>(m_queues.size());
+}
+
+////////////////////////////////////////////////////////////
+void JobSystem::workerLoop(int index)
+{
+	unsigned seenGeneration = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_wakeMutex);
+			m_wake.wait(lock, [&] { return m_stop || m_generation != seenGeneration; });
+			if (m_stop)
+			{
+				return;
+			}
+			seenGeneration = m_generation;
+		}
+
+		while (runOne(index))
+		{
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+bool JobSystem::runOne(int index)
+{
+	Chunk chunk;
+	bool found = false;
+
+	// Newest chunk from our own queue first, it is the most likely to still be in cache.
+	{
+		Queue & own = *m_queues[index];
+		std::lock_guard<std::mutex> lock(own.m_mutex);
+		if (!own.m_chunks.empty())
+		{
+			chunk = own.m_chunks.back();
+			own.m_chunks.pop_back();
+			found = true;
+		}
+	}
+
+	// Otherwise steal the oldest chunk from the next queue that has one.
+	int queueCount = static_cast<int>(m_queues.size());
+	for (int i = 1; !found && i < queueCount; i++)
+	{
+		Queue & victim = *m_queues[(index + i) % queueCount];
+		std::lock_guard<std::mutex> lock(victim.m_mutex);
+		if (!victim.m_chunks.empty())
+		{
+			chunk = victim.m_chunks.front();
+			victim.m_chunks.pop_front();
+			found = true;
+		}
+	}
+
+	if (!found)
+	{
+		return false;
+	}
+
+	(*chunk.m_job)(chunk.m_begin, chunk.m_end);
+	m_remaining.fetch_sub(1);
+	return true;
+}
@@ -1,4 +1,6 @@
 #include "LevelLoader.h"
+#include "CompiledLevel.h"
+#include <filesystem>
 
 /// The various operator >> overloads below are non-member functions used to extract
 ///  the game data from the YAML data structure.
@@ -39,6 +41,23 @@ void operator >> (const YAML::Node& backgroundNode, BackgroundData& background)
 	background.m_fileName = backgroundNode["file"].as<std::string>();
 }
 
+/// <summary>
+/// @brief Extracts the width and height of the world.
+/// 
+/// </summary>
+/// <param name="worldNode">A YAML node</param>
+/// <param name="world">A simple struct to store the world size</param>
+////////////////////////////////////////////////////////////
+void operator >> (const YAML::Node& worldNode, WorldData& world)
+{
+	world.m_size.x = worldNode["width"].as<float>();
+	world.m_size.y = worldNode["height"].as<float>();
+	if (world.m_size.x <= 0.0f || world.m_size.y <= 0.0f)
+	{
+		throw std::exception("The world width and height must be positive");
+	}
+}
+
 /// <summary>
 /// @brief Extracts the initial screen position for the player tank.
 /// 
@@ -66,9 +85,32 @@ void operator >> (const YAML::Node& levelNode, LevelData& level)
 {
 	levelNode["background"] >> level.m_background;
 
+	// Levels larger than the screen give their size under "world", the rest are one screen.
+	level.m_world = WorldData();
+	if (levelNode["world"].IsDefined())
+	{
+		levelNode["world"] >> level.m_world;
+	}
+
 	levelNode["tank"] >> level.m_tank;
 
-	levelNode["ai_tank"] >> level.m_aiTank;
+	// Levels list their AI tanks under "ai_tanks", older levels have a single "ai_tank".
+	if (levelNode["ai_tanks"].IsDefined())
+	{
+		const YAML::Node& aiTanksNode = levelNode["ai_tanks"].as<YAML::Node>();
+		for (unsigned i = 0; i < aiTanksNode.size(); ++i)
+		{
+			TankData aiTank;
+			aiTanksNode[i] >> aiTank;
+			level.m_aiTanks.push_back(aiTank);
+		}
+	}
+	else
+	{
+		TankData aiTank;
+		levelNode["ai_tank"] >> aiTank;
+		level.m_aiTanks.push_back(aiTank);
+	}
 
 	const YAML::Node& obstaclesNode = levelNode["obstacles"].as<YAML::Node>();
 	for (unsigned i = 0; i < obstaclesNode.size(); ++i)
@@ -89,20 +131,67 @@ void operator >> (const YAML::Node& levelNode, LevelData& level)
 
 ////////////////////////////////////////////////////////////
 void LevelLoader::load(int nr, LevelData& level)
+{
+	std::string yamlFile = getFileName(nr, ".yaml");
+	std::string compiledFile = getFileName(nr, ".bin");
+
+	// Use the compiled level unless the yaml has been edited since it was compiled.
+	std::error_code error;
+	auto compiledTime = std::filesystem::last_write_time(compiledFile, error);
+	if (!error)
+	{
+		auto yamlTime = std::filesystem::last_write_time(yamlFile, error);
+		if (error || compiledTime >= yamlTime)
+		{
+			try
+			{
+				CompiledLevel compiled;
+				compiled.open(compiledFile);
+				level.clear();
+				compiled.toLevelData(level);
+				return;
+			}
+			catch (std::exception& e)
+			{
+				std::cout << e.what() << std::endl;
+				std::cout << "Loading " << yamlFile << " instead." << std::endl;
+			}
+		}
+	}
+
+	loadYaml(yamlFile, level);
+}
+
+////////////////////////////////////////////////////////////
+void LevelLoader::compile(int nr)
+{
+	LevelData level;
+	loadYaml(getFileName(nr, ".yaml"), level);
+	CompiledLevel::write(level, getFileName(nr, ".bin"));
+}
+
+////////////////////////////////////////////////////////////
+std::string LevelLoader::getFileName(int nr, std::string const& extension)
 {
 	std::stringstream ss;
 	ss << ".//resources//levels//level";
 	ss << nr;
-	ss << ".yaml";
+	ss << extension;
+	return ss.str();
+}
 
+////////////////////////////////////////////////////////////
+void LevelLoader::loadYaml(std::string const& fileName, LevelData& level)
+{
 	try
 	{
-		YAML::Node baseNode = YAML::LoadFile(ss.str());
+		YAML::Node baseNode = YAML::LoadFile(fileName);
 		if (baseNode.IsNull())
 		{
-			std::string message("File: " + ss.str() + " not found");
+			std::string message("File: " + fileName + " not found");
 			throw std::exception(message.c_str());
 		}
+		level.clear();
 		baseNode >> level;
 	}
 	catch (YAML::ParserException& e)
@@ -0,0 +1,119 @@
+#include "LevelManager.h"
+#include <filesystem>
+#include <iostream>
+#include <utility>
+
+////////////////////////////////////////////////////////////
+LevelManager::LevelManager(int firstLevel)
+	: m_current(firstLevel)
+{
+}
+
+////////////////////////////////////////////////////////////
+LevelManager::~LevelManager()
+{
+	if (m_loader.joinable())
+	{
+		m_loader.join();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void LevelManager::load(LevelData & level)
+{
+	LevelLoader::load(m_current, level);
+}
+
+////////////////////////////////////////////////////////////
+void LevelManager::preloadNext()
+{
+	if (m_loader.joinable())
+	{
+		if (!m_ready)
+		{
+			return; //already loading
+		}
+		m_loader.join();
+	}
+
+	m_ready = false;
+	m_error.clear();
+	int current = m_current;
+	m_loader = std::thread([this, current]()
+	{
+		try
+		{
+			m_nextNumber = getNextNumber(current);
+			LevelLoader::load(m_nextNumber, m_next);
+		}
+		catch (std::exception & e)
+		{
+			m_error = e.what();
+		}
+		m_ready = true;
+	});
+}
+
+////////////////////////////////////////////////////////////
+bool LevelManager::isNextReady() const
+{
+	return m_ready && m_error.empty();
+}
+
+////////////////////////////////////////////////////////////
+void LevelManager::waitForNext()
+{
+	if (m_loader.joinable())
+	{
+		m_loader.join();
+	}
+}
+
+////////////////////////////////////////////////////////////
+LevelData const & LevelManager::getNext() const
+{
+	return m_next;
+}
+
+////////////////////////////////////////////////////////////
+bool LevelManager::swapInNext(LevelData & level)
+{
+	if (!m_ready)
+	{
+		return false;
+	}
+
+	waitForNext();
+
+	if (!m_error.empty())
+	{
+		std::cout << "Level loading failure." << std::endl;
+		std::cout << m_error << std::endl;
+		m_ready = false;
+		return false;
+	}
+
+	std::swap(level, m_next); //moves the containers, so nothing is copied or reallocated
+	m_current = m_nextNumber;
+	m_ready = false;
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+int LevelManager::getCurrent() const
+{
+	return m_current;
+}
+
+////////////////////////////////////////////////////////////
+int LevelManager::getNextNumber(int nr)
+{
+	std::error_code error;
+	if (std::filesystem::exists(LevelLoader::getFileName(nr + 1, ".yaml"), error) ||
+		std::filesystem::exists(LevelLoader::getFileName(nr + 1, ".bin"), error))
+	{
+		return nr + 1;
+	}
+
+	return 1;
+}
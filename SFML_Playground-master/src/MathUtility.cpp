@@ -9,7 +9,7 @@ namespace MathUtility
 	}
 
 	////////////////////////////////////////////////////////////
-	bool lineIntersectsCircle(sf::Vector2f ahead, sf::Vector2f halfAhead, sf::CircleShape circle)
+	bool lineIntersectsCircle(sf::Vector2f ahead, sf::Vector2f halfAhead, sf::CircleShape const & circle)
 	{
 		return distance(circle.getPosition(), ahead) <= circle.getRadius() ||
 			distance(circle.getPosition(), halfAhead) <= circle.getRadius();
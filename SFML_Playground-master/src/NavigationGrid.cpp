@@ -0,0 +1,83 @@
+#include "NavigationGrid.h"
+#include "CollisionDetector.h"
+#include <algorithm>
+#include <cmath>
+
+////////////////////////////////////////////////////////////
+NavigationGrid::NavigationGrid(WallGrid const & walls)
+	: m_walls(walls)
+{
+}
+
+////////////////////////////////////////////////////////////
+void NavigationGrid::build(float cellSize, float clearance)
+{
+	m_cellSize = cellSize;
+	m_columns = static_cast<int>(std::ceil(m_walls.getWorldSize().x / cellSize));
+	m_rows = static_cast<int>(std::ceil(m_walls.getWorldSize().y / cellSize));
+	m_blocked.assign(m_columns * m_rows, 0);
+
+	std::vector<int> nearbyWalls;
+	for (int row = 0; row < m_rows; row++)
+	{
+		for (int column = 0; column < m_columns; column++)
+		{
+			// The cell grown by the clearance, as a box so it can be tested against rotated walls.
+			sf::FloatRect area(column * cellSize - clearance, row * cellSize - clearance, 
+				cellSize + 2.0f * clearance, cellSize + 2.0f * clearance);
+			sf::Transform transform;
+			transform.translate(area.left, area.top);
+			OrientedBoundingBox cellBox(transform, sf::Vector2f(area.width, area.height));
+
+			m_walls.query(area, nearbyWalls);
+			for (int wall : nearbyWalls)
+			{
+				if (CollisionDetector::collision(cellBox, m_walls.getWallBox(wall)))
+				{
+					m_blocked[row * m_columns + column] = 1;
+					break;
+				}
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+int NavigationGrid::getCell(sf::Vector2f position) const
+{
+	int column = std::clamp(static_cast<int>(std::floor(position.x / m_cellSize)), 0, m_columns - 1);
+	int row = std::clamp(static_cast<int>(std::floor(position.y / m_cellSize)), 0, m_rows - 1);
+	return row * m_columns + column;
+}
+
+////////////////////////////////////////////////////////////
+sf::Vector2f NavigationGrid::getCellCentre(int cell) const
+{
+	int column = cell % m_columns;
+	int row = cell / m_columns;
+	return sf::Vector2f((column + 0.5f) * m_cellSize, (row + 0.5f) * m_cellSize);
+}
+
+////////////////////////////////////////////////////////////
+bool NavigationGrid::isBlocked(int column, int row) const
+{
+	return m_blocked[row * m_columns + column] != 0;
+}
+
+////////////////////////////////////////////////////////////
+int NavigationGrid::getColumns() const
+{
+	return m_columns;
+}
+
+////////////////////////////////////////////////////////////
+int NavigationGrid::getRows() const
+{
+	return m_rows;
+}
+
+////////////////////////////////////////////////////////////
+int NavigationGrid::getCellCount() const
+{
+	return m_columns * m_rows;
+}
@@ -1,21 +1,22 @@
 #include "OrientedBoundingBox.h"
+#include <algorithm>
 
 OrientedBoundingBox::OrientedBoundingBox(const sf::Sprite& Object) // Calculate the four points of the OBB from a transformed (scaled, rotated...) RectangleShape
+	: OrientedBoundingBox(Object.getTransform(), sf::Vector2f(Object.getLocalBounds().width, Object.getLocalBounds().height))
 {
-	sf::Transform trans = Object.getTransform();
-	sf::IntRect local = Object.getTextureRect();
-
-	float width = Object.getLocalBounds().width;
-	float height = Object.getLocalBounds().height;
+}
 
+OrientedBoundingBox::OrientedBoundingBox(const sf::Transform& Trans, const sf::Vector2f& Size) // Calculate the four points of the OBB from a transform and a local size
+{
+	Points[0] = Trans.transformPoint(0.f, 0.f);
+	Points[1] = Trans.transformPoint(Size.x, 0.f);
+	Points[2] = Trans.transformPoint(Size.x, Size.y);
+	Points[3] = Trans.transformPoint(0.f, Size.y);
 
-	Points[0] = trans.transformPoint(0.f, 0.f);
-	Points[1] = trans.transformPoint(width, 0.f);
-	Points[2] = trans.transformPoint(width, height);
-	Points[3] = trans.transformPoint(0.f, height);
+	CalculateAxesAndBounds();
 }
 
-void OrientedBoundingBox::ProjectOntoAxis(const sf::Vector2f& Axis, float& Min, float& Max) // Project all four points of the OBB onto the given axis and return the dotproducts of the two outermost points
+void OrientedBoundingBox::ProjectOntoAxis(const sf::Vector2f& Axis, float& Min, float& Max) const // Project all four points of the OBB onto the given axis and return the dotproducts of the two outermost points
 {
 	Min = (Points[0].x*Axis.x + Points[0].y*Axis.y);
 	Max = Min;
@@ -28,4 +29,19 @@ void OrientedBoundingBox::ProjectOntoAxis(const sf::Vector2f& Axis, float& Min,
 		if (Projection>Max)
 			Max = Projection;
 	}
-}
\ No newline at end of file
+}
+
+void OrientedBoundingBox::CalculateAxesAndBounds() // Fill in Axes, Bounds and the axis projections from the four points
+{
+	Axes[0] = Points[1] - Points[0];
+	Axes[1] = Points[1] - Points[2];
+
+	float Left = std::min({ Points[0].x, Points[1].x, Points[2].x, Points[3].x });
+	float Top = std::min({ Points[0].y, Points[1].y, Points[2].y, Points[3].y });
+	float Right = std::max({ Points[0].x, Points[1].x, Points[2].x, Points[3].x });
+	float Bottom = std::max({ Points[0].y, Points[1].y, Points[2].y, Points[3].y });
+	Bounds = sf::FloatRect(Left, Top, Right - Left, Bottom - Top);
+
+	for (int i = 0; i<2; i++)
+		ProjectOntoAxis(Axes[i], AxisMin[i], AxisMax[i]);
+}
@@ -0,0 +1,156 @@
+#include "ParticlePool.h"
+#include <algorithm>
+
+////////////////////////////////////////////////////////////
+ParticlePool::ParticlePool(int capacity)
+	: m_capacity(capacity)
+	, m_positionX(capacity)
+	, m_positionY(capacity)
+	, m_velocityX(capacity)
+	, m_velocityY(capacity)
+	, m_age(capacity)
+	, m_lifetime(capacity)
+	, m_style(capacity)
+	, m_vertices(capacity * 4)
+{
+}
+
+////////////////////////////////////////////////////////////
+void ParticlePool::setTexture(sf::Texture const & texture)
+{
+	m_texture = &texture;
+}
+
+////////////////////////////////////////////////////////////
+int ParticlePool::addStyle(ParticleStyle const & style)
+{
+	m_styles.push_back(style);
+	return static_cast<int>(m_styles.size()) - 1;
+}
+
+////////////////////////////////////////////////////////////
+bool ParticlePool::emit(int style, sf::Vector2f const & position, sf::Vector2f const & velocity, float lifetime)
+{
+	if (m_activeCount == m_capacity)
+	{
+		return false;
+	}
+
+	int index = m_activeCount++;
+	m_positionX[index] = position.x;
+	m_positionY[index] = position.y;
+	m_velocityX[index] = velocity.x;
+	m_velocityY[index] = velocity.y;
+	m_age[index] = 0.0f;
+	m_lifetime[index] = lifetime;
+	m_style[index] = static_cast<unsigned char>(style);
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void ParticlePool::update(float seconds)
+{
+	float drag = std::max(0.0f, 1.0f - s_DRAG * seconds);
+
+	// Moving, ageing and packing the survivors to the front in one pass over the arrays.
+	int liveCount = 0;
+	for (int i = 0; i < m_activeCount; i++)
+	{
+		float age = m_age[i] + seconds;
+		if (age >= m_lifetime[i])
+		{
+			continue;
+		}
+
+		m_positionX[liveCount] = m_positionX[i] + m_velocityX[i] * seconds;
+		m_positionY[liveCount] = m_positionY[i] + m_velocityY[i] * seconds;
+		m_velocityX[liveCount] = m_velocityX[i] * drag;
+		m_velocityY[liveCount] = m_velocityY[i] * drag;
+		m_age[liveCount] = age;
+		m_lifetime[liveCount] = m_lifetime[i];
+		m_style[liveCount] = m_style[i];
+		liveCount++;
+	}
+	m_activeCount = liveCount;
+
+	buildVertices();
+}
+
+////////////////////////////////////////////////////////////
+void ParticlePool::clear()
+{
+	m_activeCount = 0;
+}
+
+////////////////////////////////////////////////////////////
+int ParticlePool::getActiveCount() const
+{
+	return m_activeCount;
+}
+
+////////////////////////////////////////////////////////////
+int ParticlePool::getCapacity() const
+{
+	return m_capacity;
+}
+
+////////////////////////////////////////////////////////////
+void ParticlePool::buildVertices()
+{
+	sf::Vertex * vertex = m_vertices.data();
+	for (int i = 0; i < m_activeCount; i++)
+	{
+		ParticleStyle const & style = m_styles[m_style[i]];
+		float life = m_age[i] / m_lifetime[i];
+		float half = (style.m_startSize + (style.m_endSize - style.m_startSize) * life) * 0.5f;
+
+		sf::Color color = style.m_color;
+		color.a = static_cast<sf::Uint8>(color.a * (1.0f - life));
+
+		float left = m_positionX[i] - half;
+		float top = m_positionY[i] - half;
+		float right = m_positionX[i] + half;
+		float bottom = m_positionY[i] + half;
+
+		float u1 = static_cast<float>(style.m_textureRect.left);
+		float v1 = static_cast<float>(style.m_textureRect.top);
+		float u2 = u1 + style.m_textureRect.width;
+		float v2 = v1 + style.m_textureRect.height;
+
+		// Same corner order as the SpriteBatch quads. The fields are written directly because
+		//  the sf::Vertex constructors are not inline, and this loop runs for every particle.
+		vertex[0].position.x = left;
+		vertex[0].position.y = top;
+		vertex[0].texCoords.x = u1;
+		vertex[0].texCoords.y = v1;
+		vertex[1].position.x = left;
+		vertex[1].position.y = bottom;
+		vertex[1].texCoords.x = u1;
+		vertex[1].texCoords.y = v2;
+		vertex[2].position.x = right;
+		vertex[2].position.y = bottom;
+		vertex[2].texCoords.x = u2;
+		vertex[2].texCoords.y = v2;
+		vertex[3].position.x = right;
+		vertex[3].position.y = top;
+		vertex[3].texCoords.x = u2;
+		vertex[3].texCoords.y = v1;
+		vertex[0].color = color;
+		vertex[1].color = color;
+		vertex[2].color = color;
+		vertex[3].color = color;
+		vertex += 4;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void ParticlePool::draw(sf::RenderTarget & target, sf::RenderStates states) const
+{
+	if (m_activeCount == 0)
+	{
+		return;
+	}
+
+	states.texture = m_texture;
+	target.draw(m_vertices.data(), m_activeCount * 4, sf::Quads, states);
+}
@@ -0,0 +1,180 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+std::atomic<bool> Profiler::s_enabled{ false };
+ProfileSlot Profiler::s_events[Profiler::s_CAPACITY];
+std::atomic<std::uint64_t> Profiler::s_written{ 0 };
+std::atomic<std::int64_t> Profiler::s_sectionTimes[static_cast<int>(ProfileSection::COUNT)];
+std::atomic<int> Profiler::s_counters[static_cast<int>(ProfileCounter::COUNT)];
+std::int64_t Profiler::s_frameTimes[static_cast<int>(ProfileSection::COUNT)];
+double Profiler::s_averageTimes[static_cast<int>(ProfileSection::COUNT)];
+int Profiler::s_frameCounts[static_cast<int>(ProfileCounter::COUNT)];
+std::atomic<std::uint32_t> Profiler::s_frame{ 0 };
+
+// The weight of the newest frame in the averages, about a second's worth of frames at 60Hz.
+static double const s_AVERAGE_WEIGHT = 1.0 / 60.0;
+
+////////////////////////////////////////////////////////////
+void Profiler::setEnabled(bool enabled)
+{
+	s_enabled.store(enabled);
+}
+
+////////////////////////////////////////////////////////////
+std::int64_t Profiler::now()
+{
+	static auto const s_start = std::chrono::steady_clock::now();
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_start).count();
+}
+
+////////////////////////////////////////////////////////////
+void Profiler::record(ProfileSection section, std::int64_t start, std::int64_t end)
+{
+	std::uint64_t index = s_written.fetch_add(1, std::memory_order_relaxed);
+	ProfileSlot & slot = s_events[index & (s_CAPACITY - 1)];
+	std::uint64_t info = (static_cast<std::uint64_t>(s_frame.load(std::memory_order_relaxed)) << 32)
+		| (static_cast<std::uint64_t>(getThreadIndex()) << 16) | static_cast<std::uint64_t>(section);
+
+	// A seqlock: odd while the fields change, then stamped with the event number.
+	slot.m_sequence.store(index * 2 + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.m_start.store(start, std::memory_order_relaxed);
+	slot.m_duration.store(end - start, std::memory_order_relaxed);
+	slot.m_info.store(info, std::memory_order_relaxed);
+	slot.m_sequence.store(index * 2 + 2, std::memory_order_release);
+	s_sectionTimes[static_cast<int>(section)].fetch_add(end - start, std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////
+void Profiler::endFrame()
+{
+	for (int i = 0; i < static_cast<int>(ProfileSection::COUNT); i++)
+	{
+		s_frameTimes[i] = s_sectionTimes[i].exchange(0, std::memory_order_relaxed);
+		s_averageTimes[i] += (s_frameTimes[i] - s_averageTimes[i]) * s_AVERAGE_WEIGHT;
+	}
+	for (int i = 0; i < static_cast<int>(ProfileCounter::COUNT); i++)
+	{
+		s_frameCounts[i] = s_counters[i].exchange(0, std::memory_order_relaxed);
+	}
+	s_frame.fetch_add(1, std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////
+double Profiler::getFrameMs(ProfileSection section)
+{
+	return s_frameTimes[static_cast<int>(section)] / 1000000.0;
+}
+
+////////////////////////////////////////////////////////////
+double Profiler::getAverageMs(ProfileSection section)
+{
+	return s_averageTimes[static_cast<int>(section)] / 1000000.0;
+}
+
+////////////////////////////////////////////////////////////
+int Profiler::getFrameCount(ProfileCounter counter)
+{
+	return s_frameCounts[static_cast<int>(counter)];
+}
+
+////////////////////////////////////////////////////////////
+char const * Profiler::getName(ProfileSection section)
+{
+	static char const * const s_NAMES[] = { "Frame", "Update", "AI update", "Player update", "Projectiles", 
+		"Collision", "Render", "Render static layer", "Render sprites", "Render targets", "Render effects", "Render text" };
+	static_assert(sizeof(s_NAMES) / sizeof(s_NAMES[0]) == static_cast<int>(ProfileSection::COUNT), "A section has no name");
+	return s_NAMES[static_cast<int>(section)];
+}
+
+////////////////////////////////////////////////////////////
+char const * Profiler::getName(ProfileCounter counter)
+{
+	static char const * const s_NAMES[] = { "Collision tests", "Draw calls", "Static tiles painted" };
+	static_assert(sizeof(s_NAMES) / sizeof(s_NAMES[0]) == static_cast<int>(ProfileCounter::COUNT), "A counter has no name");
+	return s_NAMES[static_cast<int>(counter)];
+}
+
+////////////////////////////////////////////////////////////
+bool Profiler::writeCsv(std::string const & fileName)
+{
+	std::ofstream outputFile(fileName);
+	if (!outputFile.is_open())
+	{
+		return false;
+	}
+
+	outputFile << "frame,thread,section,start_us,duration_us" << std::endl;
+	forEachEvent([&](ProfileEvent const & event)
+	{
+		outputFile << event.m_frame << ',' << event.m_thread << ',' << getName(event.m_section) << ','
+			<< event.m_start / 1000.0 << ',' << event.m_duration / 1000.0 << '\n';
+	});
+	return static_cast<bool>(outputFile);
+}
+
+////////////////////////////////////////////////////////////
+bool Profiler::writeChromeTrace(std::string const & fileName)
+{
+	std::ofstream outputFile(fileName);
+	if (!outputFile.is_open())
+	{
+		return false;
+	}
+
+	// Complete ("X") events, with times in microseconds.
+	outputFile << "{\"traceEvents\":[" << std::endl;
+	bool first = true;
+	forEachEvent([&](ProfileEvent const & event)
+	{
+		outputFile << (first ? "" : ",\n") << "{\"name\":\"" << getName(event.m_section) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" 
+			<< event.m_thread << ",\"ts\":" << event.m_start / 1000.0 << ",\"dur\":" << event.m_duration / 1000.0 
+			<< ",\"args\":{\"frame\":" << event.m_frame << "}}";
+		first = false;
+	});
+	outputFile << std::endl << "]}" << std::endl;
+	return static_cast<bool>(outputFile);
+}
+
+////////////////////////////////////////////////////////////
+std::uint16_t Profiler::getThreadIndex()
+{
+	static std::atomic<std::uint16_t> s_nextThread{ 0 };
+	thread_local std::uint16_t const s_thread = s_nextThread.fetch_add(1);
+	return s_thread;
+}
+
+////////////////////////////////////////////////////////////
+template <typename Function>
+void Profiler::forEachEvent(Function function)
+{
+	std::uint64_t written = s_written.load();
+	std::uint64_t first = written > s_CAPACITY ? written - s_CAPACITY : 0;
+	for (std::uint64_t i = first; i < written; i++)
+	{
+		ProfileSlot const & slot = s_events[i & (s_CAPACITY - 1)];
+		std::uint64_t sequence = slot.m_sequence.load(std::memory_order_acquire);
+		if (sequence != i * 2 + 2)
+		{
+			continue; //still being written, or already overwritten by a later event
+		}
+
+		ProfileEvent event;
+		event.m_start = slot.m_start.load(std::memory_order_relaxed);
+		event.m_duration = slot.m_duration.load(std::memory_order_relaxed);
+		std::uint64_t info = slot.m_info.load(std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.m_sequence.load(std::memory_order_relaxed) != sequence)
+		{
+			continue; //overwritten while it was copied
+		}
+
+		event.m_frame = static_cast<std::uint32_t>(info >> 32);
+		event.m_thread = static_cast<std::uint16_t>(info >> 16);
+		event.m_section = static_cast<ProfileSection>(info & 0xFFFF);
+		function(event);
+	}
+}
@@ -0,0 +1,62 @@
+#include "ProfilerOverlay.h"
+#include <iomanip>
+#include <sstream>
+
+////////////////////////////////////////////////////////////
+ProfilerOverlay::ProfilerOverlay(sf::Font const & font)
+{
+	m_names.setFont(font);
+	m_names.setCharacterSize(14);
+	m_names.setFillColor(sf::Color::White);
+	m_names.setPosition(sf::Vector2f(1150.0f, 50.0f));
+
+	m_values = m_names;
+	m_values.setPosition(sf::Vector2f(1290.0f, 50.0f));
+
+	m_background.setFillColor(sf::Color(0, 0, 0, 160));
+	m_background.setPosition(sf::Vector2f(1140.0f, 45.0f));
+	m_background.setSize(sf::Vector2f(290.0f, 290.0f));
+}
+
+////////////////////////////////////////////////////////////
+void ProfilerOverlay::update()
+{
+	if (!Profiler::isEnabled() || --m_framesUntilRefresh > 0)
+	{
+		return;
+	}
+	m_framesUntilRefresh = s_REFRESH_FRAMES;
+
+	std::ostringstream names;
+	std::ostringstream values;
+	values << std::fixed << std::setprecision(2);
+
+	names << "Section\n";
+	values << "ms (average)\n";
+	for (int i = 0; i < static_cast<int>(ProfileSection::COUNT); i++)
+	{
+		ProfileSection section = static_cast<ProfileSection>(i);
+		names << Profiler::getName(section) << "\n";
+		values << Profiler::getFrameMs(section) << " (" << Profiler::getAverageMs(section) << ")\n";
+	}
+	for (int i = 0; i < static_cast<int>(ProfileCounter::COUNT); i++)
+	{
+		ProfileCounter counter = static_cast<ProfileCounter>(i);
+		names << Profiler::getName(counter) << "\n";
+		values << Profiler::getFrameCount(counter) << "\n";
+	}
+	m_names.setString(names.str());
+	m_values.setString(values.str());
+}
+
+////////////////////////////////////////////////////////////
+void ProfilerOverlay::render(sf::RenderWindow & window)
+{
+	if (Profiler::isEnabled())
+	{
+		window.draw(m_background);
+		window.draw(m_names);
+		window.draw(m_values);
+		Profiler::count(ProfileCounter::DRAW_CALLS, 3);
+	}
+}
@@ -1,64 +1,261 @@
 #include "ProjectilePool.h"
+#include "Profiler.h"
+#include <algorithm>
 
 ////////////////////////////////////////////////////////////
-void ProjectilePool::create(sf::Texture const & texture, double x, double y, double rotation)
+ProjectilePool::ProjectilePool(int size)
+	: m_size(size)
+	, m_positionX(size)
+	, m_positionY(size)
+	, m_previousX(size)
+	, m_previousY(size)
+	, m_directionX(size)
+	, m_directionY(size)
+	, m_rotation(size)
+	, m_alive(size)
 {
+}
+
+////////////////////////////////////////////////////////////
+void ProjectilePool::create(double x, double y, double rotation)
+{
+	int index = m_activeCount;
+
 	// If no projectiles available, simply re-use the next in sequence.
-	if (m_poolFull)
+	if (m_activeCount == m_size)
 	{
-		m_nextAvailable = (m_nextAvailable + 1) % s_POOL_SIZE;
+		index = m_nextReused;
+		m_nextReused = (m_nextReused + 1) % m_size;
 	}
-	
-	m_projectiles.at(m_nextAvailable).init(texture, x, y, rotation);
+	else
+	{
+		m_activeCount++;
+	}
+
+	m_positionX[index] = x;
+	m_positionY[index] = y;
+	m_previousX[index] = x; //drawn at the muzzle until its first update
+	m_previousY[index] = y;
+	m_directionX[index] = std::cos(MathUtility::DEG_TO_RAD * rotation);
+	m_directionY[index] = std::sin(MathUtility::DEG_TO_RAD * rotation);
+	m_rotation[index] = rotation;
+	m_alive[index] = 1;
 }
 
 ////////////////////////////////////////////////////////////
-int ProjectilePool::update(double dt, std::vector<sf::Sprite> & wallSprites, std::pair<sf::Sprite, sf::Sprite> aiTankSprites)
+void ProjectilePool::update(double dt, WallGrid const & walls, TankColliders const & target, int shooter, int victim, std::uint32_t tick, CollisionEventBuffer & events)
 {	
-	// The number of active projectiles.
-	int activeCount = 0;
-	// Assume the pool is not full initially.
-	m_poolFull = false;
-	int m_hitCount = 0;
+	int first = events.getCount();
+	updateTargets(dt, walls, &target, 1, shooter, tick, events);
+
+	// The only target is index 0, so give its hits the target's own id.
+	for (int i = first; i < events.getCount(); i++)
+	{
+		if (events[i].m_victim == 0)
+		{
+			events[i].m_victim = victim;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void ProjectilePool::update(double dt, WallGrid const & walls, std::vector<TankColliders> const & targets, int shooter, std::uint32_t tick, CollisionEventBuffer & events)
+{
+	updateTargets(dt, walls, targets.data(), static_cast<int>(targets.size()), shooter, tick, events);
+}
+
+////////////////////////////////////////////////////////////
+void ProjectilePool::updateTargets(double dt, WallGrid const & walls, TankColliders const * targets, int targetCount, int shooter, std::uint32_t tick, CollisionEventBuffer & events)
+{
+	ScopedTimer timer(ProfileSection::PROJECTILES);
+
+	integrate(s_MAX_SPEED * static_cast<float>(dt / 1000));
+
+	// The targets only move between pool updates, so build their bounding boxes once for all projectiles.
+	m_targetBoxes.clear();
+	for (int target = 0; target < targetCount; target++)
+	{
+		m_targetBoxes.push_back(targets[target].m_base.getBox());
+		m_targetBoxes.push_back(targets[target].m_turret.getBox());
+	}
 
-	for (int i = 0; i < s_POOL_SIZE; i++)
+	// Each projectile is swept from where it was to where it is now, so it hits whatever
+	//  it passed through, however far it moved in one update. It stops at the first hit.
+	for (int i = 0; i < m_activeCount; i++)
 	{
-		m_result = m_projectiles.at(i).update(dt, wallSprites, aiTankSprites);
+		sf::Vector2f previous(m_previousX[i], m_previousY[i]);
+		sf::Vector2f movement = sf::Vector2f(m_positionX[i], m_positionY[i]) - previous;
+		OrientedBoundingBox projectileBox = getBox(i, previous);
+
+		float firstTime = 2.0f; //later than any hit
+		int firstWall = CollisionEvent::NONE;
+		int firstTarget = CollisionEvent::NONE;
+		float time = 0.0f;
 
-		if(m_result.first)
+		// Have we passed through a nearby wall?
+		walls.query(CollisionDetector::sweptBounds(projectileBox, movement), m_nearbyWalls);
+		for (int wall : m_nearbyWalls)
 		{
-			// If this projectile has expired, make it the next available.
-			m_nextAvailable = i;
+			if (CollisionDetector::sweep(projectileBox, movement, walls.getWallBox(wall), time) && time < firstTime)
+			{
+				firstTime = time;
+				firstWall = wall;
+			}
 		}
-		else
+
+		// Or a target tank, before reaching the wall?
+		for (int target = 0; target < targetCount; target++)
 		{
-			// So we know how many projectiles are active.
-			activeCount++;
+			for (int part = 2 * target; part <= 2 * target + 1; part++)
+			{
+				if (CollisionDetector::sweep(projectileBox, movement, m_targetBoxes[part], time) && time < firstTime)
+				{
+					firstTime = time;
+					firstWall = CollisionEvent::NONE;
+					firstTarget = target;
+				}
+			}
 		}
 
-		if (m_result.second)
+		if (firstWall != CollisionEvent::NONE || firstTarget != CollisionEvent::NONE)
+		{
+			m_alive[i] = 0;
+			events.add(CollisionEvent{ shooter, firstTarget, firstWall, previous + movement * firstTime, tick });
+		}
+	}
+
+	cull(walls.getWorldSize()); //after the collisions, so a projectile that hits something on its way out of the world still counts
+
+	compact();
+}
+
+////////////////////////////////////////////////////////////
+void ProjectilePool::hashState(StateHash & hash) const
+{
+	hash.add(m_activeCount);
+	hash.add(m_nextReused);
+	hash.add(m_positionX.data(), m_activeCount * sizeof(float));
+	hash.add(m_positionY.data(), m_activeCount * sizeof(float));
+	hash.add(m_rotation.data(), m_activeCount * sizeof(float));
+}
+
+////////////////////////////////////////////////////////////
+void ProjectilePool::render(std::vector<SpriteInstance> & sprites, sf::FloatRect const & area) const
+{
+	SpriteInstance instance;
+	instance.m_origin = sf::Vector2f(m_projectileRect.width / 2.0f, m_projectileRect.height / 2.0f);
+	instance.m_textureRect = m_projectileRect;
+	for (int i = 0; i < m_activeCount; i++)
+	{
+		if (!area.contains(m_positionX[i], m_positionY[i]))
 		{
-			m_hitCount++;
+			continue;
 		}
+		instance.m_previous.m_position = sf::Vector2f(m_previousX[i], m_previousY[i]);
+		instance.m_previous.m_rotation = m_rotation[i];
+		instance.m_current.m_position = sf::Vector2f(m_positionX[i], m_positionY[i]);
+		instance.m_current.m_rotation = m_rotation[i];
+		sprites.push_back(instance);
+	}
+}
+
+////////////////////////////////////////////////////////////
+int ProjectilePool::getActiveCount() const
+{
+	return m_activeCount;
+}
+
+////////////////////////////////////////////////////////////
+int ProjectilePool::getSize() const
+{
+	return m_size;
+}
+
+////////////////////////////////////////////////////////////
+void ProjectilePool::integrate(float distance)
+{
+	// Plain loops over separate arrays, so the compiler can vectorise them.
+	float * positionX = m_positionX.data();
+	float * positionY = m_positionY.data();
+	float const * directionX = m_directionX.data();
+	float const * directionY = m_directionY.data();
+
+	// Keep where each projectile was, so drawing can blend towards where it is now.
+	std::copy(positionX, positionX + m_activeCount, m_previousX.data());
+	std::copy(positionY, positionY + m_activeCount, m_previousY.data());
+
+	for (int i = 0; i < m_activeCount; i++)
+	{
+		positionX[i] += directionX[i] * distance;
 	}
-	// If no projectiles available, set a flag.
-	if (s_POOL_SIZE == activeCount)
-	{		
-		m_poolFull = true;
+	for (int i = 0; i < m_activeCount; i++)
+	{
+		positionY[i] += directionY[i] * distance;
 	}
+}
+
+////////////////////////////////////////////////////////////
+void ProjectilePool::cull(sf::Vector2f worldSize)
+{
+	float const halfWidth = m_projectileRect.width / 2;
+	float const halfHeight = m_projectileRect.height / 2;
+	float const * positionX = m_positionX.data();
+	float const * positionY = m_positionY.data();
+	unsigned char * alive = m_alive.data();
 
-	return m_hitCount;
+	// Bitwise rather than logical and, so there are no branches in the loop.
+	for (int i = 0; i < m_activeCount; i++)
+	{
+		alive[i] &= (positionX[i] - halfWidth > 0.f)
+			& (positionX[i] + halfWidth < worldSize.x)
+			& (positionY[i] - halfHeight > 0.f)
+			& (positionY[i] + halfHeight < worldSize.y);
+	}
 }
 
 ////////////////////////////////////////////////////////////
-void ProjectilePool::render(sf::RenderWindow & window)
+void ProjectilePool::compact()
 {
-	for (int i = 0; i < s_POOL_SIZE; i++)
+	int liveCount = 0;
+	for (int i = 0; i < m_activeCount; i++)
 	{
-		// If projectile is active...
-		if (m_projectiles.at(i).inUse())
+		if (m_alive[i])
 		{
-			window.draw(m_projectiles.at(i).m_projectile);
+			m_positionX[liveCount] = m_positionX[i];
+			m_positionY[liveCount] = m_positionY[i];
+			m_previousX[liveCount] = m_previousX[i];
+			m_previousY[liveCount] = m_previousY[i];
+			m_directionX[liveCount] = m_directionX[i];
+			m_directionY[liveCount] = m_directionY[i];
+			m_rotation[liveCount] = m_rotation[i];
+			m_alive[liveCount] = 1;
+			liveCount++;
 		}
 	}
-}
\ No newline at end of file
+	m_activeCount = liveCount;
+
+	if (m_nextReused >= m_activeCount)
+	{
+		m_nextReused = 0;
+	}
+}
+
+////////////////////////////////////////////////////////////
+sf::Transform ProjectilePool::getTransform(int index, sf::Vector2f const & position) const
+{
+	// The same transform as the sprite would have: rotate about the origin (the centre), 
+	// then move to the position.
+	float cosine = m_directionX[index];
+	float sine = m_directionY[index];
+	float originX = m_projectileRect.width / 2.0f;
+	float originY = m_projectileRect.height / 2.0f;
+	return sf::Transform(cosine, -sine, position.x - (cosine * originX - sine * originY),
+		sine, cosine, position.y - (sine * originX + cosine * originY),
+		0.f, 0.f, 1.f);
+}
+
+////////////////////////////////////////////////////////////
+OrientedBoundingBox ProjectilePool::getBox(int index, sf::Vector2f const & position) const
+{
+	return OrientedBoundingBox(getTransform(index, position), sf::Vector2f(m_projectileRect.width, m_projectileRect.height));
+}
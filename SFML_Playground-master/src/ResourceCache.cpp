@@ -0,0 +1,256 @@
+#include "ResourceCache.h"
+#include <algorithm>
+#include <iostream>
+
+////////////////////////////////////////////////////////////
+ResourceCache::ResourceCache(bool loadFiles)
+	: m_loadFiles(loadFiles)
+{
+}
+
+////////////////////////////////////////////////////////////
+ResourceCache::~ResourceCache()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_wake.notify_all();
+
+	if (m_loader.joinable())
+	{
+		m_loader.join();
+	}
+}
+
+////////////////////////////////////////////////////////////
+template <typename R>
+R & ResourceCache::acquire(thor::ResourceHolder<R, std::string> & holder, std::string const & fileName, thor::ResourceLoader<R> const & loader)
+{
+	// An empty resource under the same name, so a failed file is only tried and reported once.
+	thor::ResourceLoader<R> empty([]() { return std::unique_ptr<R>(new R()); }, fileName);
+
+	if (!m_loadFiles)
+	{
+		return holder.acquire(fileName, empty, thor::Resources::Reuse);
+	}
+
+	try
+	{
+		return holder.acquire(fileName, loader, thor::Resources::Reuse);
+	}
+	catch (thor::ResourceLoadingException & e)
+	{
+		std::cout << "Error loading resource: " << e.what() << std::endl;
+		return holder.acquire(fileName, empty, thor::Resources::Reuse);
+	}
+}
+
+////////////////////////////////////////////////////////////
+sf::Texture & ResourceCache::getTexture(std::string const & fileName)
+{
+	return acquire(m_textures, fileName, thor::Resources::fromFile<sf::Texture>(fileName));
+}
+
+////////////////////////////////////////////////////////////
+sf::Font & ResourceCache::getFont(std::string const & fileName)
+{
+	return acquire(m_fonts, fileName, thor::Resources::fromFile<sf::Font>(fileName));
+}
+
+////////////////////////////////////////////////////////////
+void ResourceCache::buildAtlas(std::vector<std::string> const & fileNames)
+{
+	m_atlasRects.clear();
+
+	// The images are read even without file loading, since decoding them needs no graphics
+	//  context, so a headless game's texture rectangles and collision boxes match a windowed one's.
+	std::vector<sf::Image> images(fileNames.size());
+	unsigned width = s_ATLAS_WIDTH;
+	for (std::size_t i = 0; i < fileNames.size(); ++i)
+	{
+		if (!images[i].loadFromFile(fileNames[i]))
+		{
+			std::cout << "Error loading atlas image: " << fileNames[i] << std::endl;
+		}
+		width = std::max(width, images[i].getSize().x);
+	}
+
+	// Shelf packing: images go left to right along a row, and a new row starts below
+	//  the tallest image in the current one when the next image does not fit.
+	std::vector<sf::Vector2u> positions(images.size());
+	unsigned x = 0;
+	unsigned y = 0;
+	unsigned rowHeight = 0;
+	for (std::size_t i = 0; i < images.size(); ++i)
+	{
+		sf::Vector2u size = images[i].getSize();
+		if (x > 0 && x + size.x > width)
+		{
+			x = 0;
+			y += rowHeight + s_ATLAS_PADDING;
+			rowHeight = 0;
+		}
+
+		positions[i] = sf::Vector2u(x, y);
+		m_atlasRects[fileNames[i]] = sf::IntRect(positions[i].x, positions[i].y, size.x, size.y);
+		x += size.x + s_ATLAS_PADDING;
+		rowHeight = std::max(rowHeight, size.y);
+	}
+
+	if (!m_loadFiles)
+	{
+		return;
+	}
+
+	sf::Image atlasImage;
+	atlasImage.create(width, std::max(y + rowHeight, 1u), sf::Color::Transparent);
+	for (std::size_t i = 0; i < images.size(); ++i)
+	{
+		sf::Vector2u size = images[i].getSize();
+		if (size.x > 0 && size.y > 0)
+		{
+			atlasImage.copy(images[i], positions[i].x, positions[i].y);
+		}
+	}
+
+	if (!m_atlas.loadFromImage(atlasImage))
+	{
+		std::cout << "Error creating the texture atlas" << std::endl;
+	}
+}
+
+////////////////////////////////////////////////////////////
+sf::Texture const & ResourceCache::getAtlas() const
+{
+	return m_atlas;
+}
+
+////////////////////////////////////////////////////////////
+sf::IntRect ResourceCache::getAtlasRect(std::string const & fileName) const
+{
+	auto found = m_atlasRects.find(fileName);
+	return found != m_atlasRects.end() ? found->second : sf::IntRect();
+}
+
+////////////////////////////////////////////////////////////
+bool ResourceCache::hasTexture(std::string const & fileName)
+{
+	try
+	{
+		m_textures[fileName];
+		return true;
+	}
+	catch (thor::ResourceAccessException &)
+	{
+		return false;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void ResourceCache::loadAsync(std::vector<std::string> const & fileNames, std::function<void()> onReady)
+{
+	std::unique_ptr<Request> request(new Request());
+	request->m_onReady = onReady;
+
+	// Files already held are not read again, and a headless cache reads nothing at all.
+	for (std::string const & fileName : fileNames)
+	{
+		if (m_loadFiles && !hasTexture(fileName))
+		{
+			request->m_fileNames.push_back(fileName);
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	++m_loadingCount;
+	if (request->m_fileNames.empty())
+	{
+		m_finished.push_back(std::move(request)); //nothing to read, ready on the next update
+		return;
+	}
+
+	m_queued.push_back(std::move(request));
+	if (!m_loader.joinable())
+	{
+		m_loader = std::thread(&ResourceCache::loadLoop, this);
+	}
+	m_wake.notify_one();
+}
+
+////////////////////////////////////////////////////////////
+void ResourceCache::update()
+{
+	std::vector<std::unique_ptr<Request>> finished;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_finished.empty())
+		{
+			return;
+		}
+		finished.swap(m_finished);
+	}
+
+	for (std::unique_ptr<Request> & request : finished)
+	{
+		// Textures are uploaded here, on the thread that owns the graphics context.
+		for (std::size_t i = 0; i < request->m_fileNames.size(); ++i)
+		{
+			std::string const & fileName = request->m_fileNames[i];
+			if (request->m_loaded[i])
+			{
+				acquire(m_textures, fileName, thor::Resources::fromImage<sf::Texture>(request->m_images[i]));
+			}
+			else
+			{
+				std::cout << "Error loading texture: " << fileName << std::endl;
+				thor::ResourceLoader<sf::Texture> empty([]() { return std::unique_ptr<sf::Texture>(new sf::Texture()); }, fileName);
+				m_textures.acquire(fileName, empty, thor::Resources::Reuse);
+			}
+		}
+
+		if (request->m_onReady)
+		{
+			request->m_onReady();
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_loadingCount -= static_cast<int>(finished.size());
+}
+
+////////////////////////////////////////////////////////////
+bool ResourceCache::isLoading() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_loadingCount > 0;
+}
+
+////////////////////////////////////////////////////////////
+void ResourceCache::loadLoop()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_wake.wait(lock, [this]() { return m_stop || !m_queued.empty(); });
+		if (m_stop)
+		{
+			return;
+		}
+
+		std::unique_ptr<Request> request = std::move(m_queued.front());
+		m_queued.pop_front();
+		lock.unlock();
+
+		// Decoding is the slow part of loading an image, and needs no graphics context.
+		request->m_images.resize(request->m_fileNames.size());
+		request->m_loaded.resize(request->m_fileNames.size());
+		for (std::size_t i = 0; i < request->m_fileNames.size(); ++i)
+		{
+			request->m_loaded[i] = request->m_images[i].loadFromFile(request->m_fileNames[i]);
+		}
+
+		lock.lock();
+		m_finished.push_back(std::move(request));
+	}
+}
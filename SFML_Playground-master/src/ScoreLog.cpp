@@ -0,0 +1,285 @@
+#include "ScoreLog.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+static char const s_LOG_MAGIC[4] = { 'T', 'S', 'C', 'R' };
+static char const s_INDEX_MAGIC[4] = { 'T', 'S', 'C', 'I' };
+
+// Added to the name of a file that is not a score log when it is moved aside.
+static char const s_SET_ASIDE_EXTENSION[] = ".bad";
+
+// The number of log records read at a time when the index has to catch up.
+static int const s_READ_BLOCK = 4096;
+
+////////////////////////////////////////////////////////////
+ScoreLog::ScoreLog(std::string const & fileName, int capacity)
+	: m_fileName(fileName)
+	, m_indexFileName(fileName + ".idx")
+	, m_capacity(capacity)
+{
+}
+
+////////////////////////////////////////////////////////////
+void ScoreLog::open()
+{
+	m_top.clear();
+	m_recordCount = 0;
+	m_writable = true;
+
+	std::error_code error;
+	std::uintmax_t size = std::filesystem::file_size(m_fileName, error);
+	if (error || size == 0)
+	{
+		return; //no games have been logged yet
+	}
+
+	std::ifstream log(m_fileName, std::ios::binary);
+	ScoreLogHeader header;
+	if (!log.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+		std::memcmp(header.m_magic, s_LOG_MAGIC, sizeof(s_LOG_MAGIC)) != 0 ||
+		header.m_version != s_VERSION)
+	{
+		log.close();
+		setAside();
+		std::string message("File: " + m_fileName + " is not a score log of version " + std::to_string(s_VERSION) +
+			(m_writable ? ", moved to " + m_fileName + s_SET_ASIDE_EXTENSION : ""));
+		throw std::exception(message.c_str());
+	}
+
+	//A crash while appending can leave part of a record at the end, which is cut off
+	//so the next append starts on a record boundary again
+	int recordCount = static_cast<int>((size - sizeof(ScoreLogHeader)) / sizeof(ScoreEntry));
+	std::uintmax_t usedSize = sizeof(ScoreLogHeader) + recordCount * sizeof(ScoreEntry);
+	if (usedSize != size)
+	{
+		log.close();
+		std::filesystem::resize_file(m_fileName, usedSize, error);
+		log.open(m_fileName, std::ios::binary);
+	}
+
+	bool indexed = readIndex(recordCount);
+	if (!indexed || m_recordCount < recordCount)
+	{
+		//Only the records appended after the index was written need to be read,
+		//or the whole log if there was no usable index
+		readRecords(log, m_recordCount, recordCount);
+		m_recordCount = recordCount;
+		writeIndex();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void ScoreLog::append(std::vector<ScoreEntry> const & entries)
+{
+	if (entries.empty())
+	{
+		return;
+	}
+	if (!m_writable)
+	{
+		//Appending would mix records into a file that is not a score log
+		std::string message("File: " + m_fileName + " is not a score log and could not be moved aside");
+		throw std::exception(message.c_str());
+	}
+
+	std::error_code error;
+	std::uintmax_t size = std::filesystem::file_size(m_fileName, error);
+	bool isNew = error || size == 0;
+
+	std::ofstream log(m_fileName, std::ios::binary | std::ios::app);
+	if (!log.is_open())
+	{
+		std::string message("File: " + m_fileName + " could not be written");
+		throw std::exception(message.c_str());
+	}
+	if (isNew)
+	{
+		ScoreLogHeader header;
+		std::memcpy(header.m_magic, s_LOG_MAGIC, sizeof(s_LOG_MAGIC));
+		header.m_version = s_VERSION;
+		log.write(reinterpret_cast<char const *>(&header), sizeof(header));
+	}
+	log.write(reinterpret_cast<char const *>(entries.data()), entries.size() * sizeof(ScoreEntry));
+	log.flush();
+	if (!log)
+	{
+		std::string message("File: " + m_fileName + " could not be written");
+		throw std::exception(message.c_str());
+	}
+
+	//The records are in the log before the index counts them, so a crash in between
+	//only leaves records for the next open() to pick up
+	for (ScoreEntry const & entry : entries)
+	{
+		insert(m_top, entry, m_capacity);
+	}
+	m_recordCount += static_cast<int>(entries.size());
+	writeIndex();
+}
+
+////////////////////////////////////////////////////////////
+std::vector<ScoreEntry> const & ScoreLog::getTop() const
+{
+	return m_top;
+}
+
+////////////////////////////////////////////////////////////
+int ScoreLog::getRecordCount() const
+{
+	return m_recordCount;
+}
+
+////////////////////////////////////////////////////////////
+int ScoreLog::convertText(std::string const & textFileName, std::string const & fileName, int capacity)
+{
+	std::ifstream inputFile(textFileName);
+	if (!inputFile.is_open())
+	{
+		std::string message("File: " + textFileName + " could not be read");
+		throw std::exception(message.c_str());
+	}
+
+	std::vector<ScoreEntry> entries;
+	std::string line;
+	while (std::getline(inputFile, line))
+	{
+		//Lines look like "Score: 20  Accuracy: 62.500000"
+		std::istringstream stream(line);
+		std::string scoreLabel;
+		std::string accuracyLabel;
+		ScoreEntry entry;
+		if (stream >> scoreLabel >> entry.m_score >> accuracyLabel >> entry.m_accuracy)
+		{
+			entries.push_back(entry);
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::remove(fileName, error);
+	ScoreLog log(fileName, capacity);
+	log.append(entries);
+	return static_cast<int>(entries.size());
+}
+
+////////////////////////////////////////////////////////////
+bool ScoreLog::isHigher(ScoreEntry const & a, ScoreEntry const & b)
+{
+	return a.m_score != b.m_score ? a.m_score > b.m_score : a.m_accuracy > b.m_accuracy;
+}
+
+////////////////////////////////////////////////////////////
+void ScoreLog::insert(std::vector<ScoreEntry> & top, ScoreEntry const & entry, int capacity)
+{
+	auto position = std::upper_bound(top.begin(), top.end(), entry, isHigher);
+	if (position - top.begin() < capacity)
+	{
+		top.insert(position, entry);
+		if (static_cast<int>(top.size()) > capacity)
+		{
+			top.pop_back();
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+bool ScoreLog::readIndex(int recordCount)
+{
+	std::ifstream index(m_indexFileName, std::ios::binary);
+	ScoreIndexHeader header;
+	if (!index.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+		std::memcmp(header.m_magic, s_INDEX_MAGIC, sizeof(s_INDEX_MAGIC)) != 0 ||
+		header.m_version != s_VERSION)
+	{
+		return false;
+	}
+
+	//An index from a longer log, or one that held fewer scores than are wanted now, is rebuilt
+	std::uint32_t expectedCount = std::min(header.m_capacity, header.m_recordCount);
+	bool holdsEnough = header.m_capacity >= static_cast<std::uint32_t>(m_capacity) || header.m_count == header.m_recordCount;
+	if (header.m_recordCount > static_cast<std::uint32_t>(recordCount) || header.m_count != expectedCount || !holdsEnough)
+	{
+		return false;
+	}
+
+	std::vector<ScoreEntry> top(header.m_count);
+	if (!index.read(reinterpret_cast<char *>(top.data()), top.size() * sizeof(ScoreEntry)))
+	{
+		return false;
+	}
+	if (static_cast<int>(top.size()) > m_capacity)
+	{
+		top.resize(m_capacity);
+	}
+	m_top.swap(top);
+	m_recordCount = static_cast<int>(header.m_recordCount);
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void ScoreLog::writeIndex() const
+{
+	ScoreIndexHeader header;
+	std::memcpy(header.m_magic, s_INDEX_MAGIC, sizeof(s_INDEX_MAGIC));
+	header.m_version = s_VERSION;
+	header.m_recordCount = static_cast<std::uint32_t>(m_recordCount);
+	header.m_capacity = static_cast<std::uint32_t>(m_capacity);
+	header.m_count = static_cast<std::uint32_t>(m_top.size());
+
+	//Written beside the index and then renamed over it, so the index is never half written
+	std::string temporaryFileName = m_indexFileName + ".tmp";
+	{
+		std::ofstream index(temporaryFileName, std::ios::binary | std::ios::trunc);
+		index.write(reinterpret_cast<char const *>(&header), sizeof(header));
+		index.write(reinterpret_cast<char const *>(m_top.data()), m_top.size() * sizeof(ScoreEntry));
+		if (!index)
+		{
+			std::string message("File: " + temporaryFileName + " could not be written");
+			throw std::exception(message.c_str());
+		}
+	}
+	std::error_code error;
+	std::filesystem::rename(temporaryFileName, m_indexFileName, error);
+	if (error)
+	{
+		std::string message("File: " + m_indexFileName + " could not be replaced");
+		throw std::exception(message.c_str());
+	}
+}
+
+////////////////////////////////////////////////////////////
+void ScoreLog::setAside()
+{
+	std::error_code error;
+	std::filesystem::rename(m_fileName, m_fileName + s_SET_ASIDE_EXTENSION, error);
+	m_writable = !error;
+	if (m_writable)
+	{
+		//The index was built from the file that was moved, so the next append starts both afresh
+		std::filesystem::remove(m_indexFileName, error);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void ScoreLog::readRecords(std::istream & log, int first, int last)
+{
+	log.clear();
+	log.seekg(sizeof(ScoreLogHeader) + static_cast<std::uintmax_t>(first) * sizeof(ScoreEntry));
+
+	std::vector<ScoreEntry> block;
+	for (int begin = first; begin < last; begin += s_READ_BLOCK)
+	{
+		block.resize(std::min(s_READ_BLOCK, last - begin));
+		if (!log.read(reinterpret_cast<char *>(block.data()), block.size() * sizeof(ScoreEntry)))
+		{
+			std::string message("File: " + m_fileName + " could not be read");
+			throw std::exception(message.c_str());
+		}
+		for (ScoreEntry const & entry : block)
+		{
+			insert(m_top, entry, m_capacity);
+		}
+	}
+}
@@ -0,0 +1,141 @@
+#include "ScoreTable.h"
+#include <filesystem>
+#include <iostream>
+
+////////////////////////////////////////////////////////////
+ScoreTable::ScoreTable(std::string const & fileName, int capacity)
+	: m_fileName(fileName)
+	, m_capacity(capacity)
+	, m_log(fileName, capacity)
+{
+}
+
+////////////////////////////////////////////////////////////
+ScoreTable::~ScoreTable()
+{
+	if (m_writer.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_wake.notify_one();
+		m_writer.join(); //the writer empties the queue before it stops
+	}
+}
+
+////////////////////////////////////////////////////////////
+void ScoreTable::load(std::string const & textFileName)
+{
+	try
+	{
+		std::error_code error;
+		if (!std::filesystem::exists(m_fileName, error) && std::filesystem::exists(textFileName, error))
+		{
+			ScoreLog::convertText(textFileName, m_fileName, m_capacity);
+		}
+		m_log.open();
+		m_entries = m_log.getTop();
+	}
+	catch (std::exception& e)
+	{
+		std::cout << "Score loading failure." << std::endl;
+		std::cout << e.what() << std::endl;
+		m_entries.clear();
+	}
+	updateText();
+}
+
+////////////////////////////////////////////////////////////
+void ScoreTable::add(int score, float accuracy)
+{
+	ScoreEntry entry{ score, accuracy };
+	ScoreLog::insert(m_entries, entry, m_capacity);
+	updateText();
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pending.push_back(entry);
+	}
+	if (!m_writer.joinable())
+	{
+		m_writer = std::thread(&ScoreTable::writeLoop, this);
+	}
+	m_wake.notify_one();
+}
+
+////////////////////////////////////////////////////////////
+void ScoreTable::flush()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_written.wait(lock, [this] { return m_pending.empty() && !m_writing; });
+}
+
+////////////////////////////////////////////////////////////
+std::vector<ScoreEntry> const & ScoreTable::getEntries() const
+{
+	return m_entries;
+}
+
+////////////////////////////////////////////////////////////
+std::string const & ScoreTable::getText() const
+{
+	return m_text;
+}
+
+////////////////////////////////////////////////////////////
+int ScoreTable::getVersion() const
+{
+	return m_version;
+}
+
+////////////////////////////////////////////////////////////
+void ScoreTable::updateText()
+{
+	m_text.clear();
+	for (ScoreEntry const & entry : m_entries)
+	{
+		m_text += toLine(entry) + "\n";
+	}
+	m_version++;
+}
+
+////////////////////////////////////////////////////////////
+std::string ScoreTable::toLine(ScoreEntry const & entry)
+{
+	return "Score: " + std::to_string(entry.m_score) + "  Accuracy: " + std::to_string(entry.m_accuracy);
+}
+
+////////////////////////////////////////////////////////////
+void ScoreTable::writeLoop()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_wake.wait(lock, [this] { return m_stop || !m_pending.empty(); });
+		if (m_pending.empty())
+		{
+			return; //stopped with nothing left to write
+		}
+
+		//Take every queued result and append them with one open of the log
+		std::vector<ScoreEntry> entries;
+		entries.swap(m_pending);
+		m_writing = true;
+		lock.unlock();
+
+		try
+		{
+			m_log.append(entries);
+		}
+		catch (std::exception& e)
+		{
+			std::cout << "Score saving failure." << std::endl;
+			std::cout << e.what() << std::endl;
+		}
+
+		lock.lock();
+		m_writing = false;
+		m_written.notify_all();
+	}
+}
@@ -0,0 +1,570 @@
+#include "SimulationBenchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "CompiledLevel.h"
+#include "ParticlePool.h"
+#include <iomanip>
+
+////////////////////////////////////////////////////////////
+SimulationBenchmark::SimulationBenchmark(int ticks)
+	: m_ticks(ticks)
+{
+}
+
+////////////////////////////////////////////////////////////
+void SimulationBenchmark::run()
+{
+	std::cout << "Simulation benchmark: " << m_ticks << " ticks of " << Game::getUpdateStep() << "ms per run" << std::endl;
+	std::cout << std::setw(8) << "walls" << std::setw(12) << "total ms" << std::setw(12) << "us/tick" << std::setw(14) << "ticks/s" << std::endl;
+
+	for (int extraWalls : m_wallCounts)
+	{
+		GameSettings settings;
+		settings.m_headless = true;
+		settings.m_seed = s_SEED;
+		settings.m_extraWalls = extraWalls;
+		print(runOnce(settings));
+	}
+
+	// Randomly placed walls for the projectiles to hit.
+	srand(s_SEED);
+	std::vector<sf::Sprite> wallSprites;
+	sf::IntRect wallRect(2, 129, 33, 23);
+	for (int i = 0; i < s_PROJECTILE_WALLS; i++)
+	{
+		sf::Sprite sprite;
+		sprite.setTextureRect(wallRect);
+		sprite.setOrigin(wallRect.width / 2.0, wallRect.height / 2.0);
+		sprite.setPosition(rand() % ScreenSize::WIDTH, rand() % ScreenSize::HEIGHT);
+		sprite.setRotation(rand() % 360);
+		wallSprites.push_back(sprite);
+	}
+	WallGrid walls(wallSprites);
+	walls.build();
+
+	std::cout << std::endl << "Projectile pool benchmark: " << s_PROJECTILE_TICKS << " ticks among " << s_PROJECTILE_WALLS << " walls" << std::endl;
+	std::cout << std::setw(12) << "projectiles" << std::setw(12) << "total ms" << std::setw(12) << "us/tick" << std::endl;
+
+	for (int projectiles : m_projectileCounts)
+	{
+		double totalMs = runProjectiles(projectiles, walls);
+		std::cout << std::fixed << std::setprecision(2)
+			<< std::setw(12) << projectiles
+			<< std::setw(12) << totalMs
+			<< std::setw(12) << totalMs * 1000.0 / s_PROJECTILE_TICKS << std::endl;
+	}
+
+	std::cout << std::endl << "AI tank benchmark: " << s_AI_TANKS << " tanks for " << s_AI_TICKS << " ticks among " << s_PROJECTILE_WALLS << " walls" << std::endl;
+	std::cout << std::setw(8) << "threads" << std::setw(12) << "total ms" << std::setw(12) << "us/tick" << std::setw(10) << "speedup" << std::setw(16) << "checksum" << std::endl;
+
+	std::vector<int> threadCounts = m_threadCounts;
+	int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+	if (hardwareThreads > 0 && std::find(threadCounts.begin(), threadCounts.end(), hardwareThreads) == threadCounts.end())
+	{
+		threadCounts.push_back(hardwareThreads);
+	}
+
+	double singleThreadMs = 0.0;
+	for (int threads : threadCounts)
+	{
+		double checksum = 0.0;
+		double totalMs = runAiTanks(threads, walls, checksum);
+		if (threads == 1)
+		{
+			singleThreadMs = totalMs;
+		}
+		std::cout << std::fixed << std::setprecision(2)
+			<< std::setw(8) << threads
+			<< std::setw(12) << totalMs
+			<< std::setw(12) << totalMs * 1000.0 / s_AI_TICKS
+			<< std::setw(10) << singleThreadMs / totalMs
+			<< std::setw(16) << checksum << std::endl;
+	}
+
+	runLevelLoading();
+	runTargetPassing();
+	runParticles();
+	runLargeWorld();
+}
+
+////////////////////////////////////////////////////////////
+bool SimulationBenchmark::replay(std::string const& fileName)
+{
+	InputLog log;
+	log.load(fileName);
+	InputLogHeader const& header = log.getHeader();
+
+	GameSettings settings;
+	settings.m_headless = true;
+	settings.m_seed = header.m_seed;
+	settings.m_level = header.m_level;
+	settings.m_extraWalls = header.m_extraWalls;
+	Game game(settings);
+
+	auto start = std::chrono::steady_clock::now();
+	for (InputRun const& run : log.getRuns())
+	{
+		InputState input = InputLog::unpack(run.m_controls);
+		for (int tick = 0; tick < run.m_ticks; tick++)
+		{
+			game.step(input);
+		}
+	}
+	auto end = std::chrono::steady_clock::now();
+	double totalMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+	std::uint64_t stateHash = game.getStateHash();
+	bool matches = stateHash == header.m_stateHash;
+
+	std::cout << "Replay of " << fileName << ": " << header.m_tickCount << " ticks in " << log.getRuns().size()
+		<< " input runs, seed " << header.m_seed << ", level " << header.m_level << std::endl;
+	std::cout << std::setw(12) << "total ms" << std::setw(12) << "us/tick" << std::setw(14) << "ticks/s" << std::setw(12) << "realtime" << std::endl;
+	std::cout << std::fixed << std::setprecision(2)
+		<< std::setw(12) << totalMs
+		<< std::setw(12) << totalMs * 1000.0 / std::max(header.m_tickCount, 1u)
+		<< std::setw(14) << header.m_tickCount * 1000.0 / totalMs
+		<< std::setw(11) << header.m_tickCount * Game::getUpdateStep() / totalMs << "x" << std::endl;
+	if (matches)
+	{
+		std::cout << std::hex << "End state " << stateHash << " matches the recording" << std::dec << std::endl;
+	}
+	else
+	{
+		std::cout << std::hex << "End state " << stateHash << " does not match the recorded " << header.m_stateHash << std::dec << std::endl;
+	}
+	return matches;
+}
+
+////////////////////////////////////////////////////////////
+bool SimulationBenchmark::checkScoreLog()
+{
+	struct Case
+	{
+		char const * m_name;
+		ScoreLogHeader m_header;
+	};
+	std::vector<Case> cases{
+		{ "bad magic", { { 'J', 'U', 'N', 'K' }, 1 } },
+		{ "wrong version", { { 'T', 'S', 'C', 'R' }, 99 } }
+	};
+	std::vector<ScoreEntry> const entries{ { 20, 62.5f }, { 35, 80.0f }, { 5, 12.5f } };
+
+	std::filesystem::path directory = std::filesystem::temp_directory_path();
+	std::string fileName = (directory / "check_scores.dat").string();
+	std::string setAsideName = fileName + ".bad";
+	std::string otherName = (directory / "check_scores_other.dat").string();
+
+	bool passed = true;
+	for (Case const& check : cases)
+	{
+		std::error_code error;
+		std::filesystem::remove(setAsideName, error);
+		{
+			// A foreign header followed by a few records' worth of bytes, with another log's index beside it.
+			std::ofstream outputFile(fileName, std::ios::binary | std::ios::trunc);
+			outputFile.write(reinterpret_cast<char const *>(&check.m_header), sizeof(check.m_header));
+			outputFile.write(reinterpret_cast<char const *>(entries.data()), entries.size() * sizeof(ScoreEntry));
+		}
+		std::filesystem::remove(otherName, error);
+		ScoreLog other(otherName, 10);
+		other.append(entries);
+		std::filesystem::copy_file(otherName + ".idx", fileName + ".idx", std::filesystem::copy_options::overwrite_existing, error);
+
+		ScoreLog log(fileName, 10);
+		bool thrown = false;
+		try
+		{
+			log.open();
+		}
+		catch (std::exception&)
+		{
+			thrown = true;
+		}
+		bool setAside = std::filesystem::exists(setAsideName, error) &&
+			std::filesystem::file_size(setAsideName, error) == sizeof(check.m_header) + entries.size() * sizeof(ScoreEntry);
+
+		log.append(entries);
+		ScoreLog reopened(fileName, 10);
+		reopened.open();
+		bool fresh = reopened.getRecordCount() == static_cast<int>(entries.size()) &&
+			reopened.getTop().size() == entries.size() && reopened.getTop().front().m_score == 35 &&
+			std::filesystem::file_size(fileName, error) == sizeof(ScoreLogHeader) + entries.size() * sizeof(ScoreEntry);
+
+		bool ok = thrown && log.getRecordCount() == static_cast<int>(entries.size()) && setAside && fresh;
+		std::cout << "Score log with " << check.m_name << ": " << (ok ? "passed" : "FAILED")
+			<< " (thrown " << thrown << ", moved aside " << setAside << ", new log " << fresh << ")" << std::endl;
+		passed &= ok;
+	}
+
+	for (std::string const& name : { fileName, fileName + ".idx", setAsideName, otherName, otherName + ".idx" })
+	{
+		std::error_code error;
+		std::filesystem::remove(name, error);
+	}
+	return passed;
+}
+
+////////////////////////////////////////////////////////////
+void SimulationBenchmark::runLevelLoading() const
+{
+	std::filesystem::path directory = std::filesystem::temp_directory_path();
+	std::string yamlFile = (directory / "benchmark_level.yaml").string();
+	std::string compiledFile = (directory / "benchmark_level.bin").string();
+
+	// Write the generated level in the same yaml layout as the level files.
+	srand(s_SEED);
+	{
+		std::ofstream outputFile(yamlFile);
+		outputFile << "background:\n   file: ./resources/images/Background.jpg\n";
+		outputFile << "tank:\n   position: {x: 100, y: 100}\n";
+		outputFile << "ai_tanks:\n   - position: {x: 400, y: 700}\n";
+		outputFile << "obstacles:\n";
+		for (int i = 0; i < s_LEVEL_OBSTACLES; i++)
+		{
+			outputFile << "   - type: wall\n     position: {x: " << rand() % ScreenSize::WIDTH << ", y: " << rand() % ScreenSize::HEIGHT
+				<< "}\n     rotation: " << rand() % 360 << "\n";
+		}
+		outputFile << "target:\n   - position: {x: 750, y: 450, randomOffset: 50}\n     rotation: 90\n     spawnTime: 59\n";
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	LevelData yamlLevel;
+	LevelLoader::loadYaml(yamlFile, yamlLevel);
+	auto yamlEnd = std::chrono::steady_clock::now();
+
+	CompiledLevel::write(yamlLevel, compiledFile);
+
+	// Summing positions makes sure every obstacle is actually read.
+	auto viewStart = std::chrono::steady_clock::now();
+	float sum = 0.0f;
+	{
+		CompiledLevel compiled;
+		compiled.open(compiledFile);
+		for (CompiledObstacle const& obstacle : compiled.getObstacles())
+		{
+			sum += obstacle.m_x + obstacle.m_y;
+		}
+	}
+	auto viewEnd = std::chrono::steady_clock::now();
+
+	LevelData compiledLevel;
+	{
+		CompiledLevel compiled;
+		compiled.open(compiledFile);
+		compiled.toLevelData(compiledLevel);
+	}
+	auto copyEnd = std::chrono::steady_clock::now();
+
+	std::filesystem::remove(yamlFile);
+	std::filesystem::remove(compiledFile);
+
+	std::cout << std::endl << "Level loading benchmark: " << yamlLevel.m_obstacles.size() << " obstacles" << std::endl;
+	std::cout << std::setw(16) << "loader" << std::setw(12) << "total ms" << std::endl;
+	std::cout << std::fixed << std::setprecision(2)
+		<< std::setw(16) << "yaml" << std::setw(12) << std::chrono::duration<double, std::milli>(yamlEnd - start).count() << std::endl
+		<< std::setw(16) << "compiled views" << std::setw(12) << std::chrono::duration<double, std::milli>(viewEnd - viewStart).count() 
+		<< "   (checksum " << sum << ")" << std::endl
+		<< std::setw(16) << "compiled copy" << std::setw(12) << std::chrono::duration<double, std::milli>(copyEnd - viewEnd).count() << std::endl;
+}
+
+////////////////////////////////////////////////////////////
+double SimulationBenchmark::runAiTanks(int threads, WallGrid const& walls, double & checksum) const
+{
+	// The same tanks in the same places for every thread count.
+	srand(s_SEED);
+	std::vector<TankData> tankData(s_AI_TANKS);
+	for (TankData & tank : tankData)
+	{
+		tank.m_position.x = rand() % ScreenSize::WIDTH;
+		tank.m_position.y = rand() % ScreenSize::HEIGHT;
+	}
+
+	sf::Texture texture;
+	JobSystem jobs(threads);
+	AiTankManager aiTanks(texture, walls, jobs);
+
+	Tank player(texture, walls);
+	sf::Vector2f playerPosition(ScreenSize::WIDTH / 2.0f, ScreenSize::HEIGHT / 2.0f);
+	player.setPosition(playerPosition);
+	aiTanks.init(tankData, player.getPosition(), CounterRandom(s_SEED));
+
+	CollisionEventBuffer events;
+	auto start = std::chrono::steady_clock::now();
+	for (int tick = 0; tick < s_AI_TICKS; tick++)
+	{
+		aiTanks.update(player, Game::getUpdateStep(), tick);
+		aiTanks.applyDamage(player);
+
+		events.clear();
+		aiTanks.collectEvents(events);
+		for (CollisionEvent const & event : events)
+		{
+			if (event.m_victim == CollisionEvent::PLAYER)
+			{
+				player.takeDamage();
+			}
+		}
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	checksum = 0.0;
+	for (int i = 0; i < aiTanks.getCount(); i++)
+	{
+		sf::Vector2f position = aiTanks.getTank(i).getBaseSprite().getPosition();
+		checksum += position.x + position.y;
+	}
+
+	return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+////////////////////////////////////////////////////////////
+void SimulationBenchmark::runTargetPassing() const
+{
+	sf::Texture texture;
+	sf::Sprite base(texture, sf::IntRect(0, 0, 100, 60));
+	sf::Sprite turret(texture, sf::IntRect(0, 0, 80, 24));
+	base.setPosition(400.0f, 300.0f);
+	turret.setPosition(400.0f, 300.0f);
+
+	// A projectile sized box that is tested against the target each pass.
+	sf::Transform projectileTransform;
+	OrientedBoundingBox projectileBox(projectileTransform, sf::Vector2f(10.0f, 6.0f));
+
+	// The copies are made through a function taking the pair by value, as the pool used to.
+	auto bySprites = [&projectileBox](std::pair<sf::Sprite, sf::Sprite> target)
+	{
+		OrientedBoundingBox baseBox(target.first);
+		OrientedBoundingBox turretBox(target.second);
+		return CollisionDetector::collision(projectileBox, baseBox) || CollisionDetector::collision(projectileBox, turretBox);
+	};
+	auto byColliders = [&projectileBox](TankColliders const & target)
+	{
+		return CollisionDetector::collision(projectileBox, target.m_base.getBox())
+			|| CollisionDetector::collision(projectileBox, target.m_turret.getBox());
+	};
+
+	// The hits are counted and printed so the work cannot be optimised away.
+	int spriteHits = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < s_TARGET_PASSES; i++)
+	{
+		projectileTransform = sf::Transform().translate(static_cast<float>(i % 800), 300.0f);
+		projectileBox = OrientedBoundingBox(projectileTransform, sf::Vector2f(10.0f, 6.0f));
+		spriteHits += bySprites(std::pair<sf::Sprite, sf::Sprite>(base, turret));
+	}
+	auto middle = std::chrono::steady_clock::now();
+
+	int colliderHits = 0;
+	for (int i = 0; i < s_TARGET_PASSES; i++)
+	{
+		projectileTransform = sf::Transform().translate(static_cast<float>(i % 800), 300.0f);
+		projectileBox = OrientedBoundingBox(projectileTransform, sf::Vector2f(10.0f, 6.0f));
+		colliderHits += byColliders(TankColliders{ Collider(base), Collider(turret) });
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	double spriteMs = std::chrono::duration<double, std::milli>(middle - start).count();
+	double colliderMs = std::chrono::duration<double, std::milli>(end - middle).count();
+
+	std::cout << std::endl << "Target passing benchmark: " << s_TARGET_PASSES << " passes" << std::endl;
+	std::cout << std::setw(12) << "target" << std::setw(12) << "total ms" << std::setw(12) << "ns/pass" << std::setw(10) << "hits" << std::endl;
+	std::cout << std::fixed << std::setprecision(2)
+		<< std::setw(12) << "sprites" << std::setw(12) << spriteMs
+		<< std::setw(12) << spriteMs * 1000000.0 / s_TARGET_PASSES << std::setw(10) << spriteHits << std::endl
+		<< std::setw(12) << "colliders" << std::setw(12) << colliderMs
+		<< std::setw(12) << colliderMs * 1000000.0 / s_TARGET_PASSES << std::setw(10) << colliderHits << std::endl;
+}
+
+////////////////////////////////////////////////////////////
+double SimulationBenchmark::runProjectiles(int projectiles, WallGrid const& walls) const
+{
+	ProjectilePool pool(projectiles);
+
+	// A target far away from the walls, so projectiles only expire on walls and screen edges.
+	sf::Sprite target;
+	target.setPosition(-1000.0f, -1000.0f);
+	TankColliders targets{ Collider(target), Collider(target) };
+
+	CollisionEventBuffer events;
+	double angle = 0.0;
+	auto start = std::chrono::steady_clock::now();
+	for (int tick = 0; tick < s_PROJECTILE_TICKS; tick++)
+	{
+		// Fire from the centre of the screen to replace every projectile that expired.
+		while (pool.getActiveCount() < projectiles)
+		{
+			pool.create(ScreenSize::WIDTH / 2.0, ScreenSize::HEIGHT / 2.0, angle);
+			angle += 7.3;
+		}
+		events.clear();
+		pool.update(Game::getUpdateStep(), walls, targets, CollisionEvent::PLAYER, 0, tick, events);
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+////////////////////////////////////////////////////////////
+SimulationBenchmark::Result SimulationBenchmark::runOnce(GameSettings const& settings) const
+{
+	Game game(settings);
+
+	auto start = std::chrono::steady_clock::now();
+	for (int tick = 0; tick < m_ticks; tick++)
+	{
+		game.step(scriptedInput(tick));
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	Result result;
+	result.m_walls = game.getWallCount();
+	result.m_ticks = m_ticks;
+	result.m_totalMs = std::chrono::duration<double, std::milli>(end - start).count();
+	return result;
+}
+
+////////////////////////////////////////////////////////////
+InputState SimulationBenchmark::scriptedInput(int tick)
+{
+	InputState input;
+	input.m_up = (tick / 300) % 4 != 3; //drive forward, then coast for a while
+	input.m_right = (tick / 100) % 3 == 0; //turn in short bursts
+	input.m_turretRight = true; //keep the turret sweeping
+	input.m_fire = true; //fire whenever the reload allows
+	return input;
+}
+
+////////////////////////////////////////////////////////////
+void SimulationBenchmark::print(Result const& result)
+{
+	double usPerTick = result.m_totalMs * 1000.0 / result.m_ticks;
+	double ticksPerSecond = result.m_ticks / (result.m_totalMs / 1000.0);
+
+	std::cout << std::fixed << std::setprecision(2)
+		<< std::setw(8) << result.m_walls
+		<< std::setw(12) << result.m_totalMs
+		<< std::setw(12) << usPerTick
+		<< std::setw(14) << std::setprecision(0) << ticksPerSecond << std::endl;
+}
+
+////////////////////////////////////////////////////////////
+void SimulationBenchmark::runParticles() const
+{
+	ParticlePool pool(s_PARTICLES);
+	sf::Texture texture;
+	pool.setTexture(texture);
+	int sparks = pool.addStyle(ParticleStyle{ sf::IntRect(0, 0, 16, 16), sf::Color(255, 200, 80), 6.0f, 2.0f });
+	int dust = pool.addStyle(ParticleStyle{ sf::IntRect(16, 0, 32, 32), sf::Color(160, 140, 110, 140), 8.0f, 22.0f });
+
+	// Dead particles are replaced before every frame, so every update moves and builds s_PARTICLES quads.
+	srand(s_SEED);
+	float const seconds = 1.0f / 60.0f;
+	double updateMs = 0.0;
+	double worstMs = 0.0;
+	for (int frame = 0; frame < s_PARTICLE_FRAMES; frame++)
+	{
+		while (pool.getActiveCount() < s_PARTICLES)
+		{
+			sf::Vector2f position(static_cast<float>(rand() % ScreenSize::WIDTH), static_cast<float>(rand() % ScreenSize::HEIGHT));
+			sf::Vector2f velocity(static_cast<float>(rand() % 400 - 200), static_cast<float>(rand() % 400 - 200));
+			pool.emit(rand() % 2 == 0 ? sparks : dust, position, velocity, 0.2f + (rand() % 100) / 100.0f);
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		pool.update(seconds);
+		double frameMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		updateMs += frameMs;
+		worstMs = std::max(worstMs, frameMs);
+	}
+
+	std::cout << std::endl << "Particle benchmark: " << s_PARTICLES << " particles for " << s_PARTICLE_FRAMES << " frames, budget " << s_PARTICLE_BUDGET_MS << "ms per frame" << std::endl;
+	std::cout << std::setw(12) << "particles" << std::setw(12) << "total ms" << std::setw(12) << "ms/frame" << std::setw(12) << "worst ms" << std::setw(10) << "budget" << std::endl;
+	std::cout << std::fixed << std::setprecision(2)
+		<< std::setw(12) << s_PARTICLES
+		<< std::setw(12) << updateMs
+		<< std::setw(12) << updateMs / s_PARTICLE_FRAMES
+		<< std::setw(12) << worstMs
+		<< std::setw(10) << (updateMs / s_PARTICLE_FRAMES <= s_PARTICLE_BUDGET_MS ? "met" : "missed") << std::endl;
+}
+
+////////////////////////////////////////////////////////////
+void SimulationBenchmark::runLargeWorld() const
+{
+	std::cout << std::endl << "Large world benchmark: level " << s_LARGE_WORLD_LEVEL << ", " << m_ticks << " ticks" << std::endl;
+	std::cout << std::setw(8) << "walls" << std::setw(12) << "total ms" << std::setw(12) << "us/tick" << std::setw(14) << "ticks/s" << std::endl;
+
+	GameSettings settings;
+	settings.m_headless = true;
+	settings.m_seed = s_SEED;
+	settings.m_level = s_LARGE_WORLD_LEVEL;
+	print(runOnce(settings));
+
+	std::cout << std::endl << "Flow field benchmark: " << s_FLOW_FIELD_SEARCHES << " searches per level" << std::endl;
+	std::cout << std::setw(8) << "level" << std::setw(14) << "world" << std::setw(10) << "cells" << std::setw(12) << "cells/upd"
+		<< std::setw(12) << "upd/search" << std::setw(12) << "us/update" << std::setw(14) << "walls in view" << std::endl;
+
+	for (int nr : { 1, s_LARGE_WORLD_LEVEL })
+	{
+		LevelData level;
+		LevelLoader::load(nr, level);
+
+		// The same walls as Game::generateWalls, without a texture.
+		sf::IntRect wallRect(2, 129, 33, 23);
+		std::vector<sf::Sprite> wallSprites;
+		for (ObstacleData const& obstacle : level.m_obstacles)
+		{
+			sf::Sprite sprite;
+			sprite.setTextureRect(wallRect);
+			sprite.setOrigin(wallRect.width / 2.0, wallRect.height / 2.0);
+			sprite.setPosition(obstacle.m_position);
+			sprite.setRotation(obstacle.m_rotation);
+			wallSprites.push_back(sprite);
+		}
+		WallGrid walls(wallSprites);
+		walls.setWorldSize(level.m_world.m_size);
+		walls.build();
+
+		NavigationGrid grid(walls);
+		grid.build();
+		FlowField field(grid);
+		field.reset();
+
+		// A new goal for every search, each given the updates a search over the whole grid takes,
+		//  with every cell expanded and then pointed.
+		int searchCost = grid.getCellCount() * 2;
+		int updatesPerSearch = (searchCost + field.getCellsPerUpdate() - 1) / field.getCellsPerUpdate();
+		srand(s_SEED);
+		auto start = std::chrono::steady_clock::now();
+		for (int search = 0; search < s_FLOW_FIELD_SEARCHES; search++)
+		{
+			field.setGoal(sf::Vector2f(static_cast<float>(rand() % static_cast<int>(level.m_world.m_size.x)),
+				static_cast<float>(rand() % static_cast<int>(level.m_world.m_size.y))));
+			for (int update = 0; update < updatesPerSearch; update++)
+			{
+				field.update();
+			}
+		}
+		double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		// The walls near the view when the camera follows the player's start position.
+		Camera camera(sf::Vector2f(static_cast<float>(ScreenSize::WIDTH), static_cast<float>(ScreenSize::HEIGHT)));
+		camera.setWorldSize(level.m_world.m_size);
+		std::vector<int> visible;
+		walls.query(camera.getArea(camera.getCentre(level.m_tank.m_position)), visible);
+
+		std::ostringstream world;
+		world << level.m_world.m_size.x << "x" << level.m_world.m_size.y;
+		std::cout << std::fixed << std::setprecision(2)
+			<< std::setw(8) << nr
+			<< std::setw(14) << world.str()
+			<< std::setw(10) << grid.getCellCount()
+			<< std::setw(12) << field.getCellsPerUpdate()
+			<< std::setw(12) << updatesPerSearch
+			<< std::setw(12) << totalMs * 1000.0 / (s_FLOW_FIELD_SEARCHES * updatesPerSearch)
+			<< std::setw(14) << (std::to_string(visible.size()) + "/" + std::to_string(wallSprites.size())) << std::endl;
+	}
+}
@@ -0,0 +1,22 @@
+#include "SimulationClock.h"
+
+////////////////////////////////////////////////////////////
+SimulationClock::SimulationClock(sf::Time const & simulationTime)
+	: m_simulationTime(simulationTime)
+	, m_startTime(simulationTime)
+{
+}
+
+////////////////////////////////////////////////////////////
+sf::Time SimulationClock::getElapsedTime() const
+{
+	return m_simulationTime - m_startTime;
+}
+
+////////////////////////////////////////////////////////////
+sf::Time SimulationClock::restart()
+{
+	sf::Time elapsed = getElapsedTime();
+	m_startTime = m_simulationTime;
+	return elapsed;
+}
@@ -0,0 +1,92 @@
+#include "SpriteBatch.h"
+#include <cmath>
+#include <cstdlib>
+
+////////////////////////////////////////////////////////////
+SpriteSnapshot::SpriteSnapshot(sf::Sprite const & sprite)
+	: m_position(sprite.getPosition())
+	, m_rotation(sprite.getRotation())
+{
+}
+
+////////////////////////////////////////////////////////////
+SpriteInstance::SpriteInstance(sf::Sprite const & sprite, SpriteSnapshot const & previous)
+	: m_previous(previous)
+	, m_current(sprite)
+	, m_origin(sprite.getOrigin())
+	, m_scale(sprite.getScale())
+	, m_textureRect(sprite.getTextureRect())
+	, m_color(sprite.getColor())
+{
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setTexture(sf::Texture const & texture)
+{
+	m_texture = &texture;
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::clear()
+{
+	m_vertices.clear();
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::add(sf::Sprite const & sprite)
+{
+	add(sprite.getTransform(), sprite.getTextureRect(), sprite.getColor());
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::add(SpriteInstance const & instance, float alpha)
+{
+	SpriteSnapshot const & previous = instance.m_previous;
+	SpriteSnapshot const & current = instance.m_current;
+
+	// The difference between the rotations, taken the short way round.
+	float turn = std::fmod(current.m_rotation - previous.m_rotation + 540.0f, 360.0f) - 180.0f;
+
+	sf::Transformable blended;
+	blended.setOrigin(instance.m_origin);
+	blended.setScale(instance.m_scale);
+	blended.setPosition(previous.m_position + (current.m_position - previous.m_position) * alpha);
+	blended.setRotation(previous.m_rotation + turn * alpha);
+	add(blended.getTransform(), instance.m_textureRect, instance.m_color);
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::add(sf::Transform const & transform, sf::IntRect const & textureRect, sf::Color const & color)
+{
+	float width = static_cast<float>(std::abs(textureRect.width));
+	float height = static_cast<float>(std::abs(textureRect.height));
+
+	float left = static_cast<float>(textureRect.left);
+	float top = static_cast<float>(textureRect.top);
+	float right = left + textureRect.width;
+	float bottom = top + textureRect.height;
+
+	// Same corner order as sf::Sprite, so the quad looks identical to the drawn sprite.
+	m_vertices.append(sf::Vertex(transform.transformPoint(0.f, 0.f), color, sf::Vector2f(left, top)));
+	m_vertices.append(sf::Vertex(transform.transformPoint(0.f, height), color, sf::Vector2f(left, bottom)));
+	m_vertices.append(sf::Vertex(transform.transformPoint(width, height), color, sf::Vector2f(right, bottom)));
+	m_vertices.append(sf::Vertex(transform.transformPoint(width, 0.f), color, sf::Vector2f(right, top)));
+}
+
+////////////////////////////////////////////////////////////
+int SpriteBatch::getSpriteCount() const
+{
+	return m_vertices.getVertexCount() / 4;
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(sf::RenderTarget & target, sf::RenderStates states) const
+{
+	if (m_vertices.getVertexCount() == 0)
+	{
+		return;
+	}
+
+	states.texture = m_texture;
+	target.draw(m_vertices, states);
+}
@@ -0,0 +1,18 @@
+#include "StateHash.h"
+
+////////////////////////////////////////////////////////////
+void StateHash::add(void const * data, std::size_t size)
+{
+	unsigned char const * bytes = static_cast<unsigned char const *>(data);
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		m_value ^= bytes[i];
+		m_value *= s_PRIME;
+	}
+}
+
+////////////////////////////////////////////////////////////
+std::uint64_t StateHash::getValue() const
+{
+	return m_value;
+}
@@ -0,0 +1,117 @@
+#include "StaticLayer.h"
+#include "Profiler.h"
+#include <cmath>
+#include <exception>
+
+////////////////////////////////////////////////////////////
+StaticLayer::StaticLayer(unsigned tileSize, int maxTiles)
+	: m_tileSize(tileSize)
+	, m_maxTiles(maxTiles)
+{
+}
+
+////////////////////////////////////////////////////////////
+void StaticLayer::invalidate()
+{
+	for (Tile & tile : m_tiles)
+	{
+		tile.m_painted = false;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void StaticLayer::render(sf::RenderTarget & target, sf::FloatRect const & area, Painter const & painter)
+{
+	m_frame++;
+
+	float size = static_cast<float>(m_tileSize);
+	int firstColumn = static_cast<int>(std::floor(area.left / size));
+	int lastColumn = static_cast<int>(std::floor((area.left + area.width) / size));
+	int firstRow = static_cast<int>(std::floor(area.top / size));
+	int lastRow = static_cast<int>(std::floor((area.top + area.height) / size));
+
+	for (int row = firstRow; row <= lastRow; row++)
+	{
+		for (int column = firstColumn; column <= lastColumn; column++)
+		{
+			Tile & tile = getTile(column, row, painter);
+			m_sprite.setTexture(tile.m_texture->getTexture(), true);
+			m_sprite.setPosition(column * size, row * size);
+			target.draw(m_sprite);
+			Profiler::count(ProfileCounter::DRAW_CALLS);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+int StaticLayer::getTileCount() const
+{
+	return static_cast<int>(m_tiles.size());
+}
+
+////////////////////////////////////////////////////////////
+StaticLayer::Tile & StaticLayer::getTile(int column, int row, Painter const & painter)
+{
+	Tile * found = nullptr;
+	Tile * leastRecent = nullptr;
+	for (Tile & tile : m_tiles)
+	{
+		if (tile.m_column == column && tile.m_row == row)
+		{
+			found = &tile;
+			break;
+		}
+		// Tiles already drawn this frame are still on screen, so they are never painted over.
+		if (tile.m_lastUsed != m_frame && (!leastRecent || tile.m_lastUsed < leastRecent->m_lastUsed))
+		{
+			leastRecent = &tile;
+		}
+	}
+
+	if (!found)
+	{
+		if (static_cast<int>(m_tiles.size()) < m_maxTiles || !leastRecent)
+		{
+			m_tiles.push_back(Tile());
+			found = &m_tiles.back();
+		}
+		else
+		{
+			found = leastRecent;
+		}
+		found->m_column = column;
+		found->m_row = row;
+		found->m_painted = false;
+	}
+
+	if (!found->m_painted)
+	{
+		paint(*found, painter);
+	}
+	found->m_lastUsed = m_frame;
+	return *found;
+}
+
+////////////////////////////////////////////////////////////
+void StaticLayer::paint(Tile & tile, Painter const & painter)
+{
+	if (!tile.m_texture)
+	{
+		tile.m_texture = std::make_unique<sf::RenderTexture>();
+		if (!tile.m_texture->create(m_tileSize, m_tileSize))
+		{
+			tile.m_texture.reset();
+			throw std::exception("Could not create a static layer tile");
+		}
+	}
+
+	float size = static_cast<float>(m_tileSize);
+	sf::FloatRect area(tile.m_column * size, tile.m_row * size, size, size);
+	tile.m_texture->setView(sf::View(area));
+	tile.m_texture->clear(sf::Color::Black);
+	painter(*tile.m_texture, area);
+	tile.m_texture->display();
+
+	tile.m_painted = true;
+	Profiler::count(ProfileCounter::STATIC_TILES_PAINTED);
+}
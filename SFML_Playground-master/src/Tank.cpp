@@ -1,19 +1,24 @@
 #include "Tank.h"
+#include "AiTankManager.h"
 
-Tank::Tank(sf::Texture const & texture, std::vector<sf::Sprite>& wallSprites)
+Tank::Tank(sf::Texture const & texture, WallGrid const& walls)
 : m_texture(texture),
-m_wallSprites(wallSprites),
+m_walls(walls),
 m_health(10)
 {
 	initSprites(); //call the function to set up sprites
 }
 
-void Tank::update(double dt, bool targetsAlive[], int & score, float& accu, TankAi& aiTank)
+void Tank::update(double dt, InputState const& input, bool targetsAlive[], int & score, float& accu, AiTankManager& aiTanks, std::uint32_t tick, CollisionEventBuffer& events)
 {
+	m_lastBase = SpriteSnapshot(m_tankBase); //keep where the tank was drawn from for interpolation
+	m_lastTurret = SpriteSnapshot(m_turret);
+
 	m_previousPosition = m_tankBase.getPosition(); //set the previous tank position to the current position
 	m_previousTurretPosition = m_turret.getPosition(); //set the previous turret position to the current position
+	m_effects.clear();
 
-	handleKeyInput(); //call the function to handle input 
+	handleKeyInput(input); //call the function to handle input 
 
 	m_tankBase.setRotation(m_rotation); //set the tank rotation 
 	//get the new tank position by finding its direction multiplied by the speed
@@ -44,7 +49,15 @@ void Tank::update(double dt, bool targetsAlive[], int & score, float& accu, Tank
 		m_enablerotation = true; //enable rotation
 	}
 
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space))
+	//kick up dust every so often while driving
+	m_dustDistance += std::abs(m_speed) * (dt / 1000);
+	if (m_dustDistance >= s_DUST_SPACING)
+	{
+		m_dustDistance = 0.0;
+		m_effects.push_back(EffectEvent{ EffectType::DUST, m_tankBase.getPosition(), static_cast<float>(m_rotation) });
+	}
+
+	if (input.m_fire)
 	{
 		requestFire();
 	}
@@ -59,25 +72,21 @@ void Tank::update(double dt, bool targetsAlive[], int & score, float& accu, Tank
 		}
 	}
 	
-	m_aiTank.first = aiTank.getBaseSprite();
-	m_aiTank.second = aiTank.getTurretSprite();
-	if (m_pool.update(dt, m_wallSprites, m_aiTank) > 0)
-	{
-		aiTank.takeDamage();
-	}
+	m_pool.update(dt, m_walls, aiTanks.getColliders(), CollisionEvent::PLAYER, tick, events); //the AI tank indices are the victim ids
 
 }
 
-void Tank::render(sf::RenderWindow & window) 
+void Tank::render(std::vector<SpriteInstance> & sprites) const
 {
-	//m_pool.render(window);
-	window.draw(m_tankBase); //draw the tank base
-	window.draw(m_turret); //draw the turret
+	//m_pool.render(sprites);
+	sprites.push_back(SpriteInstance(m_tankBase, m_lastBase)); //draw the tank base
+	sprites.push_back(SpriteInstance(m_turret, m_lastTurret)); //draw the turret
 }
 
 void Tank::setPosition(sf::Vector2f & pos)
 {
-	int randPos = rand() % 4; //get a random number for the tank position
+	int randPos = nextRandom(4); //get a random number for the tank position
+	sf::Vector2f worldSize = m_walls.getWorldSize(); //mirror the position across the whole level, not just the window
 
 	if (randPos == 0) //top left
 	{
@@ -85,22 +94,35 @@ void Tank::setPosition(sf::Vector2f & pos)
 	}
 	if (randPos == 1) //top right
 	{
-		pos = { ScreenSize::WIDTH - pos.x, pos.y }; //set the pos the lenght of the window - position
+		pos = { worldSize.x - pos.x, pos.y }; //set the pos the width of the world - position
 	}
 	if (randPos == 2) //bottom left
 	{
-		pos = { pos.x, ScreenSize::HEIGHT - pos.y }; //set the pos the heigh of the window - position
+		pos = { pos.x, worldSize.y - pos.y }; //set the pos the height of the world - position
 	}
 	if (randPos == 3) //bottom right
 	{
-		pos = { ScreenSize::WIDTH - pos.x, ScreenSize::HEIGHT - pos.y }; 
+		pos = { worldSize.x - pos.x, worldSize.y - pos.y }; 
 	}
 
 	m_tankBase.setPosition(pos); //set the tank pos
 	m_turret.setPosition(pos); //set the turret pos
+	m_lastBase = SpriteSnapshot(m_tankBase); //jump straight there rather than sliding across the screen
+	m_lastTurret = SpriteSnapshot(m_turret);
 	
 }
 
+void Tank::setRandom(CounterRandom const& random)
+{
+	m_random = random;
+	m_randomDraws = 0;
+}
+
+int Tank::nextRandom(int bound)
+{
+	return m_random.getInt(bound, RandomStream::PLAYER, m_randomDraws++);
+}
+
 void Tank::increaseSpeed()
 {
 	m_previousSpeed = m_speed; //set the previous speed to the current speed
@@ -144,39 +166,39 @@ void Tank::decreaseRotation()
 	}
 }
 
-void Tank::handleKeyInput()
+void Tank::handleKeyInput(InputState const& input)
 {
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right))  //if the right arrow is pressed
+	if (input.m_right)  //if the right arrow is pressed
 	{
 		increaseRotation(); //increase the rotation
 	}
-	else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left)) //if the left arrow is pressed
+	else if (input.m_left) //if the left arrow is pressed
 	{
 		decreaseRotation(); //decrease the rotation
 	}
 	
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up)) //if the up arrow is pressed
+	if (input.m_up) //if the up arrow is pressed
 	{
 		increaseSpeed(); //increase speed
 	}
-	else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down)) //if the down arrow is pressed
+	else if (input.m_down) //if the down arrow is pressed
 	{
 		decreaseSpeed(); //decrease speed
 	}
 
 	if (m_enablerotation) //if rotation is enabled
 	{
-		if (sf::Keyboard::isKeyPressed(sf::Keyboard::X)) //if x is pressed
+		if (input.m_turretRight) //if x is pressed
 		{
 			m_centeringTurret = false; //set centering turret to false
 			increaseTurretRotation(); //increase the turret rotation
 		}
-		else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Z)) //if z is pressed
+		else if (input.m_turretLeft) //if z is pressed
 		{
 			m_centeringTurret = false; //set centering turret to false
 			decreaseTurretRotation(); //decrease the turret rotation
 		}
-		if (sf::Keyboard::isKeyPressed(sf::Keyboard::C)) //if c is pressed
+		if (input.m_centreTurret) //if c is pressed
 		{
 			m_centeringTurret = true; //set centering turret to true
 		}
@@ -227,12 +249,25 @@ void Tank::centreTurret()
 
 bool Tank::checkWallCollision()
 {
-
-	for (sf::Sprite const& sprite : m_wallSprites)
+	//Build the tank bounding boxes once and test them against the cached wall boxes
+	OrientedBoundingBox baseBox(m_tankBase);
+	OrientedBoundingBox turretBox(m_turret);
+
+	//Only test the walls that are close to the tank
+	sf::FloatRect const& baseBounds = baseBox.Bounds;
+	sf::FloatRect const& turretBounds = turretBox.Bounds;
+	float left = std::min(baseBounds.left, turretBounds.left);
+	float top = std::min(baseBounds.top, turretBounds.top);
+	float right = std::max(baseBounds.left + baseBounds.width, turretBounds.left + turretBounds.width);
+	float bottom = std::max(baseBounds.top + baseBounds.height, turretBounds.top + turretBounds.height);
+	m_walls.query(sf::FloatRect(left, top, right - left, bottom - top), m_nearbyWalls);
+
+	for (int wall : m_nearbyWalls)
 	{
+		OrientedBoundingBox const& wallBox = m_walls.getWallBox(wall);
 		//Checks if either the tank base or turret has collided with the current wall sprite.
-		if (CollisionDetector::collision(m_turret, sprite) ||
-			CollisionDetector::collision(m_tankBase, sprite))
+		if (CollisionDetector::collision(turretBox, wallBox) ||
+			CollisionDetector::collision(baseBox, wallBox))
 		{
 			return true;
 		}
@@ -297,7 +332,8 @@ void Tank::requestFire()
 		sf::Vector2f tipOfTurret(m_turret.getPosition().x + 2.0f, m_turret.getPosition().y);
 		tipOfTurret.x += std::cos(MathUtility::DEG_TO_RAD * m_turret.getRotation()) * ((m_turret.getLocalBounds().top + m_turret.getLocalBounds().height) * 1.7f);
 		tipOfTurret.y += std::sin(MathUtility::DEG_TO_RAD * m_turret.getRotation()) * ((m_turret.getLocalBounds().top + m_turret.getLocalBounds().height) * 1.7f);
-		m_pool.create(m_texture, tipOfTurret.x, tipOfTurret.y, m_turret.getRotation());
+		m_pool.create(tipOfTurret.x, tipOfTurret.y, m_turret.getRotation());
+		m_effects.push_back(EffectEvent{ EffectType::MUZZLE_FLASH, tipOfTurret, m_turret.getRotation() });
 	}
 }
 
@@ -306,9 +342,19 @@ sf::Vector2f Tank::getPosition() const
 	return m_tankBase.getPosition();
 }
 
+sf::Vector2f Tank::getLastPosition() const
+{
+	return m_lastBase.m_position;
+}
+
+TankColliders Tank::getColliders() const
+{
+	return TankColliders{ Collider(m_tankBase), Collider(m_turret) };
+}
+
 void Tank::takeDamage()
 {
-	int typeOfDamage = rand() % 2;
+	int typeOfDamage = nextRandom(2);
 
 	if (typeOfDamage == 0)
 	{
@@ -330,6 +376,20 @@ void Tank::setHealth()
 	m_health = 10;
 }
 
+void Tank::hashState(StateHash & hash) const
+{
+	hash.add(m_tankBase.getPosition());
+	hash.add(m_turret.getPosition());
+	hash.add(m_speed);
+	hash.add(m_rotation);
+	hash.add(m_turretRotation);
+	hash.add(MAX_SPEED);
+	hash.add(m_health);
+	hash.add(m_shootTimer);
+	hash.add(m_randomDraws);
+	m_pool.hashState(hash);
+}
+
 void Tank::initSprites()
 {
 	// Initialise the tank base
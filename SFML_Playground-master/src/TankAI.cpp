@@ -1,53 +1,99 @@
 #include "TankAi.h"
+#include <algorithm>
+
+sf::Color const TankAi::s_PATROL_VISION{ 255, 255, 255, 40 };
+sf::Color const TankAi::s_ATTACK_VISION{ 255, 0, 0, 60 };
+
+////////////////////////////////////////////////////////////
+void ObstacleCircles::build(WallGrid const & walls)
+{
+	m_circles.clear();
+	m_maxRadius = 0.0f;
+	for (int i = 0; i < walls.getWallCount(); i++)
+	{
+		sf::Sprite const & wallSprite = walls.getWall(i);
+		sf::CircleShape circle(wallSprite.getTextureRect().width * 1.5f);
+		circle.setOrigin(circle.getRadius(), circle.getRadius());
+		circle.setPosition(wallSprite.getPosition());
+		m_circles.push_back(circle);
+		m_maxRadius = std::max(m_maxRadius, circle.getRadius());
+	}
+}
 
 ////////////////////////////////////////////////////////////
-TankAi::TankAi(sf::Texture const & texture, std::vector<sf::Sprite> & wallSprites)
+TankAi::TankAi(sf::Texture const & texture, WallGrid const & walls)
 	: m_aiBehaviour(AiBehaviour::PATROL_MAP)
 	, m_texture(texture)
-	, m_wallSprites(wallSprites)
+	, m_walls(walls)
 	, m_steering(0, 0)
 	, m_health(10)
 {
 	// Initialises the tank base and turret sprites.
 	initSprites();
 
-	vision.append(sf::Vertex{ sf::Vector2f(-1,-1), sf::Color::Black });
-
-	for (int i = 1; i <= 10; i++)
-	{
-		vision.append(sf::Vertex{ sf::Vector2f(-1,-1), sf::Color::Black });
-	}
+	vision.resize(1 + s_VISION_RAYS);
+}
 
-	vision.append(sf::Vertex{ m_tankBase.getPosition(), sf::Color::White });
-	vision.append(sf::Vertex{ sf::Vector2f(m_tankBase.getPosition().x, m_tankBase.getPosition().y * acos(FOV / 2) + 200) , sf::Color::White });
-	vision.append(sf::Vertex{ sf::Vector2f(m_tankBase.getPosition().x, m_tankBase.getPosition().y + 200), sf::Color::White });
-	vision.append(sf::Vertex{ sf::Vector2f(m_tankBase.getPosition().x, m_tankBase.getPosition().y * acos(FOV) + 200),  sf::Color::White });
-	vision.append(sf::Vertex{ m_tankBase.getPosition(), sf::Color::White });
+////////////////////////////////////////////////////////////
+void TankAi::update(Tank const & playerTank, double dt, std::uint32_t tick)
+{
+	steer(playerTank.getPosition(), playerTank.getColliders(), dt, tick);
 }
 
 ////////////////////////////////////////////////////////////
-void TankAi::update(Tank const & playerTank, double dt)
+void TankAi::steer(sf::Vector2f playerPosition, TankColliders const & playerColliders, double dt, std::uint32_t tick)
 {
-	sf::Vector2f vectorToPlayer = seek(playerTank.getPosition());
+	m_lastBase = SpriteSnapshot(m_tankBase);
+	m_lastTurret = SpriteSnapshot(m_turret);
+	m_effects.clear();
+	m_playerPosition = playerPosition;
+
+	// Keep heading for the same patrol point until it is reached or the time runs out,
+	//  a new point every update just makes the tank wander on the spot.
+	if (m_aiBehaviour == AiBehaviour::PATROL_MAP &&
+		(m_patrolTime <= 0.0 || MathUtility::distance(m_tankBase.getPosition(), m_patrolTarget) < PATROL_REACHED))
+	{
+		std::uint32_t stream = RandomStream::AI_TANKS + m_index;
+		sf::Vector2f worldSize = m_walls.getWorldSize();
+		float x = m_random.getInt(static_cast<int>(worldSize.x), stream, tick, 0);
+		float y = m_random.getInt(static_cast<int>(worldSize.y), stream, tick, 1);
+		m_patrolTarget = sf::Vector2f(x, y);
+		m_patrolTime = PATROL_TIME;
+	}
+
+	sf::Vector2f vectorToPlayer = seek(m_playerPosition);
 
 	sf::Vector2f acceleration;
 
 	switch (m_aiBehaviour)
 	{
 	case AiBehaviour::ATTACK_PLAYER:
-		m_steering += thor::unitVector(vectorToPlayer);
-		m_steering += collisionAvoidance();
+	{
+		// The flow field already leads around the walls with room to spare, so it needs no
+		//  avoidance. Seek directly in the player's cell or where the field has no path.
+		sf::Vector2f flow = m_flowField != nullptr ? m_flowField->getDirection(m_tankBase.getPosition()) : sf::Vector2f(0, 0);
+		if (flow != sf::Vector2f(0, 0))
+		{
+			m_steering += flow;
+		}
+		else
+		{
+			m_steering += thor::unitVector(vectorToPlayer);
+			m_steering += collisionAvoidance();
+		}
 		m_steering = MathUtility::truncate(m_steering, MAX_FORCE);
 		acceleration = m_steering / MASS;
 		//m_velocity = MathUtility::truncate(m_velocity + m_steering, MAX_SPEED);
 		m_velocity = MathUtility::truncate(m_velocity + acceleration, MAX_SPEED);
 		break;
+	}
 	case AiBehaviour::STOP:
 		m_velocity = sf::Vector2f(0, 0);
 		//motion->m_speed = 0;
 		break;
 	case AiBehaviour::PATROL_MAP:
-		m_steering += thor::unitVector(seek(sf::Vector2f( rand () % ScreenSize::WIDTH, rand() % ScreenSize::HEIGHT)));
+		m_patrolTime -= dt;
+		m_steering += thor::unitVector(seek(m_patrolTarget));
 		m_steering += collisionAvoidance();
 		m_steering = MathUtility::truncate(m_steering, MAX_FORCE);
 		acceleration = m_steering / MASS;
@@ -58,16 +104,16 @@ void TankAi::update(Tank const & playerTank, double dt)
 		break;
 	}
 
-	if (m_tankBase.getPosition().x < 0 || m_tankBase.getPosition().x > ScreenSize::WIDTH)
+	if (m_tankBase.getPosition().x < 0 || m_tankBase.getPosition().x > m_walls.getWorldSize().x)
 	{
 		m_velocity.x *= -1;
 	}
-	if (m_tankBase.getPosition().y < 0 || m_tankBase.getPosition().y > ScreenSize::HEIGHT)
+	if (m_tankBase.getPosition().y < 0 || m_tankBase.getPosition().y > m_walls.getWorldSize().y)
 	{
 		m_velocity.y *= -1;
 	}
 
-	lookForPlayer(playerTank.getPosition());
+	lookForPlayer(m_playerPosition);
 
 	// Now we need to convert our velocity vector into a rotation angle between 0 and 359 degrees.
 	// The m_velocity vector works like this: vector(1,0) is 0 degrees, while vector(0, 1) is 90 degrees.
@@ -111,42 +157,73 @@ void TankAi::update(Tank const & playerTank, double dt)
 		}
 	}
 
-	if (m_pool.update(dt, m_wallSprites, std::pair<sf::Sprite, sf::Sprite>(playerTank.getBase(), playerTank.getTurret())) > 0)
+	m_events.clear();
+	m_pool.update(dt, m_walls, playerColliders, m_index, CollisionEvent::PLAYER, tick, m_events);
+}
+
+////////////////////////////////////////////////////////////
+CollisionEventBuffer const & TankAi::getEvents() const
+{
+	return m_events;
+}
+
+////////////////////////////////////////////////////////////
+std::vector<EffectEvent> const & TankAi::getEffects() const
+{
+	return m_effects;
+}
+
+////////////////////////////////////////////////////////////
+void TankAi::render(std::vector<SpriteInstance> & sprites, sf::FloatRect const & area) const
+{
+	// The projectiles fly on after the tank is out of sight, so they are culled on their own.
+	m_pool.render(sprites, area);
+	if (area.contains(m_tankBase.getPosition()))
 	{
-		m_hitTarget = true;
+		sprites.push_back(SpriteInstance(m_tankBase, m_lastBase));
+		sprites.push_back(SpriteInstance(m_turret, m_lastTurret));
 	}
 }
 
 ////////////////////////////////////////////////////////////
-void TankAi::render(sf::RenderWindow & window)
+sf::VertexArray const & TankAi::getVision() const
 {
-	// TODO: Don't draw if off-screen...
-	m_pool.render(window);
-	window.draw(m_tankBase);
-	window.draw(m_turret);
-	window.draw(vision);
+	return vision;
 }
 
 ////////////////////////////////////////////////////////////
-void TankAi::init(sf::Vector2f position)
+void TankAi::init(sf::Vector2f position, ObstacleCircles const & obstacles, FlowField const * flowField, int index,
+	CounterRandom const & random)
 {
 	m_tankBase.setPosition(position);
 	m_turret.setPosition(position);
-
-	for (sf::Sprite const wallSprite : m_wallSprites)
-	{
-		sf::CircleShape circle(wallSprite.getTextureRect().width * 1.5f);
-		circle.setOrigin(circle.getRadius(), circle.getRadius());
-		circle.setPosition(wallSprite.getPosition());
-		m_obstacles.push_back(circle);
-	}
+	m_lastBase = SpriteSnapshot(m_tankBase);
+	m_lastTurret = SpriteSnapshot(m_turret);
+
+	m_obstacles = &obstacles;
+	m_flowField = flowField;
+	m_index = index;
+	m_random = random;
+	m_events.clear();
+	m_effects.clear();
+	m_dustDistance = 0.0;
+	m_patrolTime = 0.0;
 	m_health = 10;
 }
+
+////////////////////////////////////////////////////////////
 bool TankAi::collidesWithPlayer(Tank const& playerTank) const
+{
+	TankColliders playerColliders = playerTank.getColliders();
+	return collidesWithPlayer(playerColliders.m_base.getBox(), playerColliders.m_turret.getBox());
+}
+
+////////////////////////////////////////////////////////////
+bool TankAi::collidesWithPlayer(OrientedBoundingBox const& playerBase, OrientedBoundingBox const& playerTurret) const
 {
 	// Checks if the AI tank has collided with the player tank.
-	if (CollisionDetector::collision(m_turret, playerTank.getTurret()) ||
-		CollisionDetector::collision(m_tankBase, playerTank.getBase()))
+	if (CollisionDetector::collision(OrientedBoundingBox(m_turret), playerTurret) ||
+		CollisionDetector::collision(OrientedBoundingBox(m_tankBase), playerBase))
 	{
 		return true;
 	}
@@ -167,12 +244,12 @@ sf::Vector2f TankAi::collisionAvoidance()
 	sf::Vector2f headingVector(std::cos(headingRadians) * MAX_SEE_AHEAD, std::sin(headingRadians) * MAX_SEE_AHEAD);
 	m_ahead = m_tankBase.getPosition() + headingVector;
 	m_halfAhead = m_tankBase.getPosition() + (headingVector * 0.5f);
-	const sf::CircleShape mostThreatening = findMostThreateningObstacle();
+	sf::CircleShape const * mostThreatening = findMostThreateningObstacle();
 	sf::Vector2f avoidance(0, 0);
-	if (mostThreatening.getRadius() != 0.0)
+	if (mostThreatening != nullptr)
 	{		
-		avoidance.x = m_ahead.x - mostThreatening.getPosition().x;
-		avoidance.y = m_ahead.y - mostThreatening.getPosition().y;
+		avoidance.x = m_ahead.x - mostThreatening->getPosition().x;
+		avoidance.y = m_ahead.y - mostThreatening->getPosition().y;
 		avoidance = thor::unitVector(avoidance);
 		avoidance *= MAX_AVOID_FORCE;
 	}
@@ -184,13 +261,22 @@ sf::Vector2f TankAi::collisionAvoidance()
 }
 
 ////////////////////////////////////////////////////////////
-const sf::CircleShape TankAi::findMostThreateningObstacle()
+sf::CircleShape const * TankAi::findMostThreateningObstacle()
 {
-	// The initialisation of mostThreatening is just a placeholder...
-	sf::CircleShape mostThreatening;
-
-	for (auto circle : m_obstacles)
+	// Points into the shared obstacle circles rather than copying one, nullptr means no threat.
+	sf::CircleShape const * mostThreatening = nullptr;
+
+	// Only the obstacles whose circles can reach the ahead line need testing.
+	float maxRadius = m_obstacles->m_maxRadius;
+	float left = std::min(m_ahead.x, m_halfAhead.x) - maxRadius;
+	float top = std::min(m_ahead.y, m_halfAhead.y) - maxRadius;
+	float right = std::max(m_ahead.x, m_halfAhead.x) + maxRadius;
+	float bottom = std::max(m_ahead.y, m_halfAhead.y) + maxRadius;
+	m_walls.query(sf::FloatRect(left, top, right - left, bottom - top), m_nearbyWalls);
+
+	for (int obstacle : m_nearbyWalls)
 	{
+		sf::CircleShape const & circle = m_obstacles->m_circles[obstacle];
 		bool collides = MathUtility::lineIntersectsCircle(m_ahead, m_halfAhead, circle);
 
 		float distance = MathUtility::distance(m_ahead, circle.getPosition());
@@ -201,26 +287,31 @@ const sf::CircleShape TankAi::findMostThreateningObstacle()
 			continue;
 		}
 
-		if (collides && (mostThreatening.getRadius() == 0.0f || (MathUtility::distance(m_tankBase.getPosition(), circle.getPosition()) <
-			MathUtility::distance(m_tankBase.getPosition(), mostThreatening.getPosition()))))
+		if (collides && (mostThreatening == nullptr || (MathUtility::distance(m_tankBase.getPosition(), circle.getPosition()) <
+			MathUtility::distance(m_tankBase.getPosition(), mostThreatening->getPosition()))))
 		{
-			mostThreatening = circle;
+			mostThreatening = &circle;
 		}
 	}
 
 	return mostThreatening;
 }
 
-sf::Sprite TankAi::getBaseSprite()
+sf::Sprite const & TankAi::getBaseSprite() const
 {
 	return m_tankBase;
 }
 
-sf::Sprite TankAi::getTurretSprite()
+sf::Sprite const & TankAi::getTurretSprite() const
 {
 	return m_turret;
 }
 
+TankColliders TankAi::getColliders() const
+{
+	return TankColliders{ Collider(m_tankBase), Collider(m_turret) };
+}
+
 void TankAi::takeDamage()
 {
 	m_health--;
@@ -231,23 +322,139 @@ int TankAi::getHealth()
 	return m_health;
 }
 
+////////////////////////////////////////////////////////////
+void TankAi::hashState(StateHash & hash) const
+{
+	hash.add(m_tankBase.getPosition());
+	hash.add(m_velocity);
+	hash.add(m_steering);
+	hash.add(m_rotation);
+	hash.add(m_turretRotation);
+	hash.add(m_patrolTarget);
+	hash.add(m_patrolTime);
+	hash.add(m_aiBehaviour);
+	hash.add(m_health);
+	hash.add(m_shootTimer);
+	m_pool.hashState(hash);
+}
+
+////////////////////////////////////////////////////////////
 void TankAi::lookForPlayer(sf::Vector2f t_player)
 {
-	vision[0] = sf::Vertex{ m_tankBase.getPosition(), sf::Color::Black };
-	vision[1] = sf::Vertex{ sf::Vector2f(m_tankBase.getPosition().x, m_tankBase.getPosition().y + (FOV/2)*200) , sf::Color::Black };
-	vision[2] = sf::Vertex{ sf::Vector2f(m_tankBase.getPosition().x, m_tankBase.getPosition().y + (FOV / 2) * 200) , sf::Color::Black };
-	vision[3] = sf::Vertex{ sf::Vector2f(m_tankBase.getPosition().x, m_tankBase.getPosition().y * 200), sf::Color::Black };
-	vision[4] = sf::Vertex{ sf::Vector2f(m_tankBase.getPosition().x, m_tankBase.getPosition().y * 200), sf::Color::Black };
-	vision[5] = sf::Vertex{ sf::Vector2f(m_tankBase.getPosition().x, m_tankBase.getPosition().y + (FOV) * 200),  sf::Color::Black };
-	vision[6] = sf::Vertex{ sf::Vector2f(m_tankBase.getPosition().x, m_tankBase.getPosition().y + (FOV) * 200),  sf::Color::Black };
-	vision[7] = sf::Vertex{ m_tankBase.getPosition(), sf::Color::Black };
-	vision[8] = sf::Vertex{ m_tankBase.getPosition(), sf::Color::Black };
-	vision[9] = sf::Vertex{ m_tankBase.getPosition(), sf::Color::Black };
+	sf::Vector2f position = m_tankBase.getPosition();
+	float const halfFov = MathUtility::DEG_TO_RAD * FOV / 2.0f;
+	float const step = 2.0f * halfFov / (s_VISION_RAYS - 1);
+	float const facing = MathUtility::DEG_TO_RAD * m_rotation;
+
+	// Each ray starts at full length, and the area under the cone is the rectangle around its ends.
+	sf::Vector2f directions[s_VISION_RAYS];
+	float lengths[s_VISION_RAYS];
+	float left = position.x;
+	float top = position.y;
+	float right = position.x;
+	float bottom = position.y;
+	for (int i = 0; i < s_VISION_RAYS; i++)
+	{
+		float angle = facing - halfFov + i * step;
+		directions[i] = sf::Vector2f(std::cos(angle), std::sin(angle));
+		lengths[i] = SPOT_DISTANCE;
+		sf::Vector2f end = position + directions[i] * lengths[i];
+		left = std::min(left, end.x);
+		top = std::min(top, end.y);
+		right = std::max(right, end.x);
+		bottom = std::max(bottom, end.y);
+	}
+
+	// The player is a candidate if in range and inside the field of view, then the rectangle
+	//  must cover the line to them as well.
+	sf::Vector2f toPlayer = t_player - position;
+	float playerDistance = thor::length(toPlayer);
+	bool inCone = false;
+	if (playerDistance <= SPOT_DISTANCE)
+	{
+		sf::Vector2f forward(std::cos(facing), std::sin(facing));
+		inCone = playerDistance == 0.0f || std::abs(thor::signedAngle(forward, toPlayer)) <= FOV / 2.0f;
+	}
+	if (inCone)
+	{
+		left = std::min(left, t_player.x);
+		top = std::min(top, t_player.y);
+		right = std::max(right, t_player.x);
+		bottom = std::max(bottom, t_player.y);
+	}
+
+	m_walls.query(sf::FloatRect(left, top, right - left, bottom - top), m_nearbyWalls);
 
+	// The outward normals of the cone's two edges. The cone is narrower than a half turn,
+	//  so a wall entirely beyond either edge is outside it.
+	sf::Vector2f firstEdgeNormal = -thor::perpendicularVector(directions[0]);
+	sf::Vector2f lastEdgeNormal = thor::perpendicularVector(directions[s_VISION_RAYS - 1]);
 
+	// Keep the walls that may be in the cone, nearest first, so the near walls cut the rays short
+	//  and the walls behind them are passed over without a ray cast.
+	m_visibleWalls.clear();
+	for (int wall : m_nearbyWalls)
+	{
+		sf::Vector2f centre;
+		float radius;
+		getWallCircle(m_walls.getWallBox(wall), centre, radius);
+		sf::Vector2f toWall = centre - position;
+		if (thor::dotProduct(toWall, firstEdgeNormal) <= radius && thor::dotProduct(toWall, lastEdgeNormal) <= radius &&
+			thor::squaredLength(toWall) <= (SPOT_DISTANCE + radius) * (SPOT_DISTANCE + radius))
+		{
+			m_visibleWalls.push_back(std::make_pair(thor::squaredLength(toWall), wall));
+		}
+	}
+	std::sort(m_visibleWalls.begin(), m_visibleWalls.end());
+
+	bool blocked = false;
+	for (std::pair<float, int> const & visibleWall : m_visibleWalls)
+	{
+		OrientedBoundingBox const & box = m_walls.getWallBox(visibleWall.second);
+		sf::Vector2f centre;
+		float radius;
+		getWallCircle(box, centre, radius);
+		sf::Vector2f toWall = centre - position;
+
+		// Only the rays that pass through the circle around the wall before their end
+		//  can hit it. The rays turn across the wall in order, so once a ray has passed the circle
+		//  so have the rest. Each hit can only shorten a ray, so a ray is tested only up to its nearest hit so far.
+		for (int i = 0; i < s_VISION_RAYS; i++)
+		{
+			float across = thor::crossProduct(directions[i], toWall);
+			if (across > radius)
+			{
+				continue;
+			}
+			if (across < -radius)
+			{
+				break;
+			}
+
+			float time;
+			if (thor::dotProduct(directions[i], toWall) - radius < lengths[i] &&
+				CollisionDetector::rayCast(position, directions[i] * lengths[i], box, time))
+			{
+				lengths[i] *= time;
+			}
+		}
+
+		if (inCone && !blocked)
+		{
+			float time;
+			blocked = CollisionDetector::rayCast(position, toPlayer, box, time);
+		}
+	}
+
+	bool spotted = inCone && !blocked;
+	sf::Color const & color = spotted ? s_ATTACK_VISION : s_PATROL_VISION;
+	vision[0] = sf::Vertex{ position, color };
+	for (int i = 0; i < s_VISION_RAYS; i++)
+	{
+		vision[i + 1] = sf::Vertex{ position + directions[i] * lengths[i], color };
+	}
 
-	//if inside the cone and less then the spot distance
-	if (thor::length(t_player - m_tankBase.getPosition()) <= SPOT_DISTANCE)
+	if (spotted)
 	{
 		m_aiBehaviour = AiBehaviour::ATTACK_PLAYER;
 	}
@@ -257,6 +464,14 @@ void TankAi::lookForPlayer(sf::Vector2f t_player)
 	}
 }
 
+////////////////////////////////////////////////////////////
+void TankAi::getWallCircle(OrientedBoundingBox const & box, sf::Vector2f & centre, float & radius)
+{
+	// The diagonal of the box is the circle's diameter.
+	centre = (box.Points[0] + box.Points[2]) / 2.0f;
+	radius = thor::length(box.Points[2] - box.Points[0]) / 2.0f;
+}
+
 ////////////////////////////////////////////////////////////
 void TankAi::initSprites()
 {
@@ -284,6 +499,13 @@ void TankAi::updateMovement(double dt)
 	m_tankBase.setRotation(m_rotation);
 	m_turret.setPosition(m_tankBase.getPosition());
 	m_turret.setRotation(m_rotation+m_turretRotation);
+
+	m_dustDistance += speed * (dt / 1000);
+	if (m_dustDistance >= s_DUST_SPACING)
+	{
+		m_dustDistance = 0.0;
+		m_effects.push_back(EffectEvent{ EffectType::DUST, newPos, static_cast<float>(m_rotation) });
+	}
 }
 
 void TankAi::requestFire()
@@ -294,6 +516,7 @@ void TankAi::requestFire()
 		sf::Vector2f tipOfTurret(m_turret.getPosition().x + 2.0f, m_turret.getPosition().y);
 		tipOfTurret.x += std::cos(MathUtility::DEG_TO_RAD * m_turret.getRotation()) * ((m_turret.getLocalBounds().top + m_turret.getLocalBounds().height) * 1.7f);
 		tipOfTurret.y += std::sin(MathUtility::DEG_TO_RAD * m_turret.getRotation()) * ((m_turret.getLocalBounds().top + m_turret.getLocalBounds().height) * 1.7f);
-		m_pool.create(m_texture, tipOfTurret.x, tipOfTurret.y, m_turret.getRotation());
+		m_pool.create(tipOfTurret.x, tipOfTurret.y, m_turret.getRotation());
+		m_effects.push_back(EffectEvent{ EffectType::MUZZLE_FLASH, tipOfTurret, m_turret.getRotation() });
 	}
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "TextBatch.h"
+
+// The space left around each glyph, in pixels.
+static float const s_PADDING = 1.0f;
+
+////////////////////////////////////////////////////////////
+TextBatch::TextBatch(sf::Font const & font, unsigned int characterSize)
+	: m_font(font)
+	, m_characterSize(characterSize)
+{
+}
+
+////////////////////////////////////////////////////////////
+void TextBatch::clear()
+{
+	m_vertices.clear();
+}
+
+////////////////////////////////////////////////////////////
+void TextBatch::add(std::string const & string, sf::Vector2f const & position, sf::Color const & color)
+{
+	float lineSpacing = m_font.getLineSpacing(m_characterSize);
+	float x = 0.0f;
+	float y = static_cast<float>(m_characterSize); //the first baseline, as in sf::Text
+
+	sf::Uint32 previous = 0;
+	for (char character : string)
+	{
+		sf::Uint32 current = static_cast<unsigned char>(character);
+		x += m_font.getKerning(previous, current, m_characterSize);
+		previous = current;
+
+		if (current == '\n')
+		{
+			x = 0.0f;
+			y += lineSpacing;
+			continue;
+		}
+
+		sf::Glyph const & glyph = m_font.getGlyph(current, m_characterSize, false);
+
+		if (glyph.textureRect.width > 0 && glyph.textureRect.height > 0) //spaces only move the pen
+		{
+			// Same one pixel padding and triangles as sf::Text, so the batch looks identical to the drawn text.
+			float left = position.x + x + glyph.bounds.left - s_PADDING;
+			float top = position.y + y + glyph.bounds.top - s_PADDING;
+			float right = position.x + x + glyph.bounds.left + glyph.bounds.width + s_PADDING;
+			float bottom = position.y + y + glyph.bounds.top + glyph.bounds.height + s_PADDING;
+
+			float u1 = glyph.textureRect.left - s_PADDING;
+			float v1 = glyph.textureRect.top - s_PADDING;
+			float u2 = glyph.textureRect.left + glyph.textureRect.width + s_PADDING;
+			float v2 = glyph.textureRect.top + glyph.textureRect.height + s_PADDING;
+
+			m_vertices.append(sf::Vertex(sf::Vector2f(left, top), color, sf::Vector2f(u1, v1)));
+			m_vertices.append(sf::Vertex(sf::Vector2f(right, top), color, sf::Vector2f(u2, v1)));
+			m_vertices.append(sf::Vertex(sf::Vector2f(left, bottom), color, sf::Vector2f(u1, v2)));
+			m_vertices.append(sf::Vertex(sf::Vector2f(left, bottom), color, sf::Vector2f(u1, v2)));
+			m_vertices.append(sf::Vertex(sf::Vector2f(right, top), color, sf::Vector2f(u2, v1)));
+			m_vertices.append(sf::Vertex(sf::Vector2f(right, bottom), color, sf::Vector2f(u2, v2)));
+		}
+
+		x += glyph.advance;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void TextBatch::draw(sf::RenderTarget & target, sf::RenderStates states) const
+{
+	if (m_vertices.getVertexCount() == 0)
+	{
+		return;
+	}
+
+	// Fetched at draw time, as the glyph texture grows when new characters are first used.
+	states.texture = &m_font.getTexture(m_characterSize);
+	target.draw(m_vertices, states);
+}
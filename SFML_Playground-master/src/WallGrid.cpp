@@ -0,0 +1,159 @@
+#include "WallGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+////////////////////////////////////////////////////////////
+WallGrid::WallGrid(std::vector<sf::Sprite> const & wallSprites)
+	: m_wallSprites(wallSprites)
+{
+}
+
+////////////////////////////////////////////////////////////
+void WallGrid::build(float cellSize)
+{
+	m_cellSize = cellSize;
+	m_maxHalfSize = sf::Vector2f(0.0f, 0.0f);
+	m_cellStart.clear();
+	m_cellWalls.clear();
+	m_wallBoxes.clear();
+
+	if (m_wallSprites.empty())
+	{
+		m_columns = 0;
+		m_rows = 0;
+		return;
+	}
+
+	// Cache the bounding boxes, then find the extent of the walls and the centre of each wall.
+	std::vector<sf::Vector2f> centres;
+	centres.reserve(m_wallSprites.size());
+	m_wallBoxes.reserve(m_wallSprites.size());
+	sf::Vector2f min(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+	sf::Vector2f max(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest());
+
+	for (sf::Sprite const & sprite : m_wallSprites)
+	{
+		m_wallBoxes.push_back(OrientedBoundingBox(sprite));
+		sf::FloatRect bounds = m_wallBoxes.back().Bounds;
+		sf::Vector2f centre(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height / 2.0f);
+		centres.push_back(centre);
+
+		m_maxHalfSize.x = std::max(m_maxHalfSize.x, bounds.width / 2.0f);
+		m_maxHalfSize.y = std::max(m_maxHalfSize.y, bounds.height / 2.0f);
+		min.x = std::min(min.x, centre.x);
+		min.y = std::min(min.y, centre.y);
+		max.x = std::max(max.x, centre.x);
+		max.y = std::max(max.y, centre.y);
+	}
+
+	m_origin = min;
+	m_columns = static_cast<int>((max.x - min.x) / m_cellSize) + 1;
+	m_rows = static_cast<int>((max.y - min.y) / m_cellSize) + 1;
+
+	// Counting sort of the walls by cell: count, prefix sum, then scatter.
+	std::vector<int> wallCell(centres.size());
+	m_cellStart.assign(m_columns * m_rows + 1, 0);
+	for (int i = 0; i < static_cast<int>(centres.size()); i++)
+	{
+		wallCell[i] = getRow(centres[i].y) * m_columns + getColumn(centres[i].x);
+		m_cellStart[wallCell[i] + 1]++;
+	}
+	for (int cell = 0; cell < m_columns * m_rows; cell++)
+	{
+		m_cellStart[cell + 1] += m_cellStart[cell];
+	}
+
+	std::vector<int> insertAt(m_cellStart.begin(), m_cellStart.end() - 1);
+	m_cellWalls.resize(centres.size());
+	for (int i = 0; i < static_cast<int>(centres.size()); i++)
+	{
+		m_cellWalls[insertAt[wallCell[i]]++] = i;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void WallGrid::query(sf::FloatRect const & area, std::vector<int> & result) const
+{
+	result.clear();
+
+	if (m_cellWalls.empty())
+	{
+		return;
+	}
+
+	// A wall is stored by its centre, so any wall overlapping the area has its centre
+	// inside the area grown by the largest wall half size.
+	float left = area.left - m_maxHalfSize.x;
+	float top = area.top - m_maxHalfSize.y;
+	float right = area.left + area.width + m_maxHalfSize.x;
+	float bottom = area.top + area.height + m_maxHalfSize.y;
+
+	// Entirely outside the grid, nothing to find.
+	if (right < m_origin.x || bottom < m_origin.y ||
+		left > m_origin.x + m_columns * m_cellSize || top > m_origin.y + m_rows * m_cellSize)
+	{
+		return;
+	}
+
+	int firstColumn = getColumn(left);
+	int lastColumn = getColumn(right);
+	int firstRow = getRow(top);
+	int lastRow = getRow(bottom);
+
+	for (int row = firstRow; row <= lastRow; row++)
+	{
+		for (int column = firstColumn; column <= lastColumn; column++)
+		{
+			int cell = row * m_columns + column;
+			for (int i = m_cellStart[cell]; i < m_cellStart[cell + 1]; i++)
+			{
+				result.push_back(m_cellWalls[i]);
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+sf::Sprite const & WallGrid::getWall(int index) const
+{
+	return m_wallSprites[index];
+}
+
+////////////////////////////////////////////////////////////
+OrientedBoundingBox const & WallGrid::getWallBox(int index) const
+{
+	return m_wallBoxes[index];
+}
+
+////////////////////////////////////////////////////////////
+int WallGrid::getWallCount() const
+{
+	return static_cast<int>(m_wallSprites.size());
+}
+
+////////////////////////////////////////////////////////////
+void WallGrid::setWorldSize(sf::Vector2f const & size)
+{
+	m_worldSize = size;
+}
+
+////////////////////////////////////////////////////////////
+sf::Vector2f WallGrid::getWorldSize() const
+{
+	return m_worldSize;
+}
+
+////////////////////////////////////////////////////////////
+int WallGrid::getColumn(float x) const
+{
+	int column = static_cast<int>(std::floor((x - m_origin.x) / m_cellSize));
+	return std::clamp(column, 0, m_columns - 1);
+}
+
+////////////////////////////////////////////////////////////
+int WallGrid::getRow(float y) const
+{
+	int row = static_cast<int>(std::floor((y - m_origin.y) / m_cellSize));
+	return std::clamp(row, 0, m_rows - 1);
+}
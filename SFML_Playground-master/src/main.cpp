@@ -19,17 +19,105 @@
 
 
 #include "Game.h"
+#include "SimulationBenchmark.h"
+#include <string>
 
 /// <summary>
 /// @brief starting point for all C++ programs.
 /// 
 /// Create a game object and run it.
+/// Passing --benchmark [ticks] runs the headless simulation benchmark instead.
+/// Passing --compile-level [nr] compiles levelnr.yaml to the binary levelnr.bin.
+/// Passing --convert-scores [text] [log] converts a text score file to a binary score log.
+/// Passing --profile starts the game with the profiler and its overlay enabled.
+/// Passing --threaded runs the simulation on its own thread.
+/// Passing --record [file] records the input of the game to a file when it closes.
+/// Passing --replay [file] plays a recorded game again headlessly and checks it ends the same.
+/// Passing --check-scores checks that unreadable score logs are moved aside and replaced.
 /// </summary>
-/// <param name=""></param>
+/// <param name="argc"></param>
 /// <param name="argv"></param>
 /// <returns></returns>
-int main(int, char* argv[])
+int main(int argc, char* argv[])
 {
-	Game game;
+	if (argc > 1 && std::string(argv[1]) == "--benchmark")
+	{
+		int ticks = argc > 2 ? std::stoi(argv[2]) : 20000;
+		SimulationBenchmark benchmark(ticks);
+		benchmark.run();
+		return 0;
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "--compile-level")
+	{
+		int nr = argc > 2 ? std::stoi(argv[2]) : 1;
+		try
+		{
+			LevelLoader::compile(nr);
+		}
+		catch (std::exception& e)
+		{
+			std::cout << e.what() << std::endl;
+			return 1;
+		}
+		std::cout << "Compiled " << LevelLoader::getFileName(nr, ".bin") << std::endl;
+		return 0;
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "--convert-scores")
+	{
+		std::string textFileName = argc > 2 ? argv[2] : ".//resources//data//scores.txt";
+		std::string fileName = argc > 3 ? argv[3] : ".//resources//data//scores.dat";
+		try
+		{
+			int count = ScoreLog::convertText(textFileName, fileName, 10);
+			std::cout << "Converted " << count << " scores to " << fileName << std::endl;
+		}
+		catch (std::exception& e)
+		{
+			std::cout << e.what() << std::endl;
+			return 1;
+		}
+		return 0;
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "--replay")
+	{
+		std::string fileName = argc > 2 ? argv[2] : "game.input";
+		try
+		{
+			return SimulationBenchmark::replay(fileName) ? 0 : 1;
+		}
+		catch (std::exception& e)
+		{
+			std::cout << e.what() << std::endl;
+			return 1;
+		}
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "--check-scores")
+	{
+		try
+		{
+			return SimulationBenchmark::checkScoreLog() ? 0 : 1;
+		}
+		catch (std::exception& e)
+		{
+			std::cout << e.what() << std::endl;
+			return 1;
+		}
+	}
+
+	GameSettings settings;
+	for (int i = 1; i < argc; i++)
+	{
+		settings.m_profile |= std::string(argv[i]) == "--profile";
+		settings.m_simulationThread |= std::string(argv[i]) == "--threaded";
+		if (std::string(argv[i]) == "--record")
+		{
+			settings.m_recordFile = i + 1 < argc && argv[i + 1][0] != '-' ? argv[i + 1] : "game.input";
+		}
+	}
+	Game game(settings);
 	game.run();
 }
\ No newline at end of file